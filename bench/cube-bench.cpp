@@ -0,0 +1,191 @@
+// renders cube headlessly (EGL pbuffer, eg. on Mesa llvmpipe), to compare
+// cube drawing and cell states upload cost across changes without browser
+//
+// usage: cube-bench [frames count] [quality tier] [gles version]
+//
+// gles version 2 forces WebGL1 path even where GLES3 is available
+
+#include <GLES2/gl2.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "../src/drawers/cube-drawer/cube-drawer.hpp"
+#include "../src/drawers/cube-side-drawer.hpp"
+#include "../src/helpers/board.hpp"
+#include "../src/helpers/cube.hpp"
+#include "../src/helpers/graphics-math.hpp"
+#include "../src/models/GameState.hpp"
+#include "../src/models/QualityTier.hpp"
+#include "../src/platform/platform.hpp"
+
+const int CANVAS_WIDTH = 1280;
+const int CANVAS_HEIGHT = 720;
+const int DEFAULT_FRAMES_COUNT = 300;
+const int SIDE_CELLS_PER_ROW = 30;
+const int BOARD_CHANGES_SIZE = 256;
+const int SNAKE_LENGTH = 10;
+
+enum class EBoardUpdate {
+  None,
+
+  // snake head takes cell and tail frees one, as on each game tick
+  SnakeMove,
+
+  // all sides changing (eg. on level start)
+  AllSides,
+};
+
+struct Scenario {
+  const char* name;
+  EBoardUpdate board_update;
+};
+
+const std::array<Scenario, 3> SCENARIOS{{
+    {.name = "rotate", .board_update = EBoardUpdate::None},
+    {.name = "rotate + snake move", .board_update = EBoardUpdate::SnakeMove},
+    {.name = "rotate + 6 sides upload", .board_update = EBoardUpdate::AllSides},
+}};
+
+void initBenchState(GameState* state, int tier, int gles_version) {
+  auto& scene = state->scene;
+  auto& cube = scene.cube;
+
+  scene.css_size = {.width = CANVAS_WIDTH, .height = CANVAS_HEIGHT};
+  scene.canvas = Canvas{.width = CANVAS_WIDTH,
+                        .height = CANVAS_HEIGHT,
+                        .max_gles_version = gles_version};
+  scene.frame_governor.tier = tier;
+
+  cube.grid = {.rows_count = SIDE_CELLS_PER_ROW,
+               .cols_count = SIDE_CELLS_PER_ROW};
+
+  auto& board = state->board;
+  resetBoard(&board, getCellsCount(cube.grid));
+  board.changes.resize(BOARD_CHANGES_SIZE);
+
+  for (int cell_idx = 0; cell_idx < SNAKE_LENGTH; ++cell_idx) {
+    setBoardCell(&board, cell_idx, ECellContent::Snake);
+  }
+}
+
+// moves snake along cells order, so it crosses to next side from time to time
+void updateBoard(GameState* state, EBoardUpdate board_update, int frame) {
+  auto& board = state->board;
+  auto& cube = state->scene.cube;
+  const auto cells_count = static_cast<int>(board.cells.size());
+
+  switch (board_update) {
+    case EBoardUpdate::None:
+      return;
+    case EBoardUpdate::SnakeMove:
+      setBoardCell(&board, (frame + SNAKE_LENGTH) % cells_count,
+                   ECellContent::Snake);
+      setBoardCell(&board, frame % cells_count, ECellContent::Empty);
+      break;
+    case EBoardUpdate::AllSides:
+      for (auto& [side_type, side] : cube.sides) {
+        side.needs_redraw = true;
+      }
+      break;
+  }
+
+  collectDirtyCellsLoop(state);
+}
+
+auto getPercentile(std::vector<double> samples, double percentile) -> double {
+  const auto idx = static_cast<size_t>(percentile * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + idx, samples.end());
+  return samples[idx];
+}
+
+// times each frame up to the moment GPU is done with it, since drawing calls
+// themselves only queue commands
+void runScenario(GameState* state, const Scenario& scenario,
+                 int frames_count) {
+  auto& cube = state->scene.cube;
+  const auto& gl_state = state->scene.gl_state;
+  const auto issued_calls_start = gl_state.issued_calls_count;
+  const auto filtered_calls_start = gl_state.filtered_calls_count;
+  std::vector<double> frame_times;
+  frame_times.reserve(frames_count);
+
+  for (int frame = 0; frame < frames_count; ++frame) {
+    updateBoard(state, scenario.board_update, frame);
+
+    cube.current_orientation = getQuaternionForRotation(
+        {.x = frame * 0.7, .y = frame * 1.3});
+    cube.needs_redraw = true;
+
+    const auto frame_start = getNow();
+
+    drawCubeLoop(state);
+    glFinish();
+
+    frame_times.push_back(getNow() - frame_start);
+  }
+
+  double total = 0;
+  for (const auto time : frame_times) {
+    total += time;
+  }
+
+  std::printf(
+      "%-26s mean %7.3f ms  p50 %7.3f ms  p95 %7.3f ms  "
+      "GL state calls issued %lld, filtered %lld\n",
+      scenario.name, total / frames_count, getPercentile(frame_times, 0.5),
+      getPercentile(frame_times, 0.95),
+      static_cast<long long>(gl_state.issued_calls_count - issued_calls_start),
+      static_cast<long long>(gl_state.filtered_calls_count -
+                             filtered_calls_start));
+}
+
+auto main(int argc, char** argv) -> int {
+  const auto frames_count =
+      argc > 1 ? std::atoi(argv[1]) : DEFAULT_FRAMES_COUNT;  // NOLINT
+  const auto tier = argc > 2 ? std::atoi(argv[2]) : 0;       // NOLINT
+  const auto gles_version = argc > 3 ? std::atoi(argv[3]) : 3;  // NOLINT
+
+  if (frames_count <= 0 || tier < 0 ||
+      tier >= static_cast<int>(QUALITY_TIERS.size()) || gles_version < 2 ||
+      gles_version > 3) {
+    std::fprintf(stderr, "usage: cube-bench [frames count] [quality tier] "
+                         "[gles version]\n");
+    return EXIT_FAILURE;
+  }
+
+  auto state = std::make_unique<GameState>();
+  initBenchState(state.get(), tier, gles_version);
+
+  initCubeDrawer(state.get());
+
+  const auto& cube = state->scene.cube;
+  const auto& startup = state->stats.startup;
+
+  std::printf("renderer: %s\n",
+              reinterpret_cast<const char*>(  // NOLINT
+                  glGetString(GL_RENDERER)));
+  std::printf("GLES%d path, canvas %dx%d, side %dx%d cells, tier %d\n",
+              cube.webgl_version + 1, CANVAS_WIDTH, CANVAS_HEIGHT,
+              cube.grid.cols_count, cube.grid.rows_count, tier);
+  std::printf(
+      "startup: context %.3f ms, shaders %.3f ms, first upload %.3f ms\n",
+      startup.context_creation, startup.shaders_compilation,
+      startup.first_texture_upload);
+
+  for (const auto& scenario : SCENARIOS) {
+    runScenario(state.get(), scenario, frames_count);
+  }
+
+  // drawing which GL rejects would still be timed, so it is reported instead
+  if (const auto error = glGetError(); error != GL_NO_ERROR) {
+    std::printf("FAILED: GL error 0x%04x\n", error);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
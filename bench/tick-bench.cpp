@@ -0,0 +1,119 @@
+// times game ticks natively, to see what snapshot recording (board journal,
+// tick deltas and keyframes) adds to a snake move, and what rewinds cost.
+// snake follows apples, so it grows long on big grid. each scenario starts
+// from the same seed, so plain moves and recorded ticks play the same game
+//
+// usage: tick-bench [ticks count]
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+#include "../src/actions/game-actions.hpp"
+#include "../src/actions/snake-actions.hpp"
+#include "../src/actions/snapshot-actions.hpp"
+#include "../src/platform/platform.hpp"
+
+const int DEFAULT_TICKS_COUNT = 20000;
+const int REWIND_TICKS_COUNT = 16;
+const int REWIND_PERIOD = 64;
+
+enum class ETickKind {
+  // moveSnake, without recording
+  Move,
+
+  // playTick, which records tick for rewinding
+  RecordedMove,
+
+  // playTick, and rewind by REWIND_TICKS_COUNT every REWIND_PERIOD ticks
+  Rewind,
+};
+
+struct Scenario {
+  const char* name;
+  ETickKind tick_kind;
+};
+
+const std::array<Scenario, 3> SCENARIOS{{
+    {.name = "move", .tick_kind = ETickKind::Move},
+    {.name = "recorded move", .tick_kind = ETickKind::RecordedMove},
+    {.name = "rewind", .tick_kind = ETickKind::Rewind},
+}};
+
+auto createBenchState() -> std::unique_ptr<GameState> {
+  auto state = std::make_unique<GameState>();
+  state->board.random_engine.seed(1);
+  state->config = {.grid_size = 64,
+                   .apples_count = 200,
+                   .respawn_apples = true,
+                   .stones_count = 0};
+
+  initGameState(state.get());
+  startOrPauseGame(state.get());
+
+  return state;
+}
+
+void runScenario(const Scenario& scenario, int ticks_count) {
+  auto state = createBenchState();
+
+  double moves_time = 0;
+  double rewinds_time = 0;
+  int rewinds_count = 0;
+  int rounds_count = 1;
+  std::size_t max_snake_length = 0;
+
+  for (int i = 0; i < ticks_count; ++i) {
+    // steering is the same in all scenarios, so it is left out of timing
+    steerToNearestApple(state.get());
+
+    const auto move_start = getNow();
+    if (scenario.tick_kind == ETickKind::Move) {
+      moveSnake(state.get());
+    } else {
+      playTick(state.get());
+    }
+    moves_time += getNow() - move_start;
+
+    if (scenario.tick_kind == ETickKind::Rewind && i % REWIND_PERIOD == 0) {
+      const auto rewind_start = getNow();
+      restoreSnapshot(state.get(), state->snapshots.tick - REWIND_TICKS_COUNT);
+      rewinds_time += getNow() - rewind_start;
+      rewinds_count += 1;
+    }
+
+    max_snake_length = std::max(max_snake_length, state->snake.parts.size());
+
+    if (state->snake.is_crashed || state->board.apples_count == 0) {
+      plantObjects(state.get());
+      rounds_count += 1;
+    }
+  }
+
+  std::printf("%-14s tick %7.3f us", scenario.name,
+              moves_time * 1000 / ticks_count);
+  if (rewinds_count > 0) {
+    std::printf("  rewind by %d ticks %7.3f us", REWIND_TICKS_COUNT,
+                rewinds_time * 1000 / rewinds_count);
+  }
+  std::printf("  (%d rounds, snake up to %zu parts)\n", rounds_count,
+              max_snake_length);
+}
+
+auto main(int argc, char** argv) -> int {
+  const auto ticks_count =
+      argc > 1 ? std::atoi(argv[1]) : DEFAULT_TICKS_COUNT;  // NOLINT
+
+  if (ticks_count <= 0) {
+    std::fprintf(stderr, "usage: tick-bench [ticks count]\n");
+    return EXIT_FAILURE;
+  }
+
+  for (const auto& scenario : SCENARIOS) {
+    runScenario(scenario, ticks_count);
+  }
+
+  return EXIT_SUCCESS;
+}
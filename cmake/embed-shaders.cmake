@@ -0,0 +1,30 @@
+# generates c++ header with GLSL shader sources embedded as string constants.
+# each shader file "name.glsl" becomes "constexpr std::string_view
+# name_shader_src" (non-alphanumeric chars in name are replaced with "_")
+#
+# usage: cmake -DSHADERS="a.glsl;b.glsl" -DOUTPUT=shaders.hpp -P embed-shaders.cmake
+
+set(CONTENT "#pragma once\n\n")
+string(APPEND CONTENT "// generated by cmake/embed-shaders.cmake, do not edit\n\n")
+string(APPEND CONTENT "#include <string_view>\n")
+
+foreach(SHADER ${SHADERS})
+    get_filename_component(SHADER_FILE_NAME ${SHADER} NAME)
+    get_filename_component(SHADER_NAME ${SHADER} NAME_WE)
+    string(MAKE_C_IDENTIFIER ${SHADER_NAME} SHADER_NAME)
+    file(READ ${SHADER} SHADER_SOURCE)
+
+    string(APPEND CONTENT "\n// ${SHADER_FILE_NAME}\n")
+    string(APPEND CONTENT "constexpr std::string_view ${SHADER_NAME}_shader_src = R\"glsl(")
+    string(APPEND CONTENT "${SHADER_SOURCE}")
+    string(APPEND CONTENT ")glsl\";\n")
+endforeach()
+
+# do not touch output if nothing changed to avoid needless recompilation
+if(EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} OLD_CONTENT)
+endif()
+
+if(NOT "${CONTENT}" STREQUAL "${OLD_CONTENT}")
+    file(WRITE ${OUTPUT} "${CONTENT}")
+endif()
@@ -0,0 +1,9 @@
+# prints size of built file, to keep an eye on download size
+#
+# usage: cmake -DFILE=main.wasm -P report-size.cmake
+
+file(SIZE ${FILE} FILE_SIZE)
+math(EXPR FILE_SIZE_KB "${FILE_SIZE} / 1024")
+get_filename_component(FILE_NAME ${FILE} NAME)
+
+message(STATUS "${FILE_NAME} size: ${FILE_SIZE_KB} KB (${FILE_SIZE} bytes)")
@@ -2,6 +2,8 @@
 
 #include "../drawers/scene-drawer.hpp"
 #include "../helpers/direction.hpp"
+#include "../helpers/graphics-math.hpp"
+#include "../helpers/key-bindings.hpp"
 #include "../helpers/ranges.hpp"
 #include "../models/ECameraMode.hpp"
 #include "../models/EDirection.hpp"
@@ -9,19 +11,27 @@
 #include "game-actions.hpp"
 #include "snake-actions.hpp"
 
-void onKeyDown(GameState* state, const std::string& key_code) {
+void onKeyDown(GameState* state, std::string_view key_code, double key_time) {
   std::optional<EDirection> direction;
 
-  if (key_code == "ArrowUp" || key_code == "KeyW") {
-    direction = EDirection::Up;
-  } else if (key_code == "ArrowDown" || key_code == "KeyS") {
-    direction = EDirection::Down;
-  } else if (key_code == "ArrowLeft" || key_code == "KeyA") {
-    direction = EDirection::Left;
-  } else if (key_code == "ArrowRight" || key_code == "KeyD") {
-    direction = EDirection::Right;
-  } else if (key_code == "Space" || key_code == "Enter") {
-    startOrPauseGame(state);
+  switch (getKeyAction(state->key_bindings, key_code)) {
+    case EKeyAction::TurnUp:
+      direction = EDirection::Up;
+      break;
+    case EKeyAction::TurnDown:
+      direction = EDirection::Down;
+      break;
+    case EKeyAction::TurnLeft:
+      direction = EDirection::Left;
+      break;
+    case EKeyAction::TurnRight:
+      direction = EDirection::Right;
+      break;
+    case EKeyAction::StartOrPause:
+      startOrPauseGame(state);
+      break;
+    case EKeyAction::None:
+      break;
   }
 
   if (direction.has_value()) {
@@ -34,7 +44,7 @@ void onKeyDown(GameState* state, const std::string& key_code) {
       direction = getOppositeDirection(direction.value());
     }
 
-    setSnakeDirection(state, direction.value());
+    queueSnakeTurn(state, direction.value(), key_time);
   }
 }
 
@@ -50,12 +60,29 @@ void onMouseDown(GameState* state) {
 void onMouseUp(GameState* state) {
   auto& cube = state->scene.cube;
 
+  // moves made before release still count
+  applyMouseMoveLoop(state);
+
   cube.mouse_is_dragging = false;
   cube.mouse_pos.reset();
 }
 
 void onMouseMove(GameState* state, Point2D mouse_pos) {
+  if (state->scene.cube.mouse_is_dragging) {
+    state->input.mouse_pos = mouse_pos;
+  }
+}
+
+void applyMouseMoveLoop(GameState* state) {
   auto& cube = state->scene.cube;
+  auto& input = state->input;
+
+  if (!input.mouse_pos.has_value()) {
+    return;
+  }
+
+  const auto mouse_pos = input.mouse_pos.value();
+  input.mouse_pos.reset();
 
   if (!cube.mouse_is_dragging) {
     return;
@@ -72,7 +99,8 @@ void onMouseMove(GameState* state, Point2D mouse_pos) {
     cube.target_rotation.x = normalizeDegrees(cube.target_rotation.x);
     cube.target_rotation.y = normalizeDegrees(cube.target_rotation.y);
 
-    cube.current_rotation = cube.target_rotation;
+    cube.target_orientation = getQuaternionForRotation(cube.target_rotation);
+    cube.current_orientation = cube.target_orientation;
 
     cube.needs_redraw = true;
   }
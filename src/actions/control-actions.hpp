@@ -2,11 +2,14 @@
 
 #include <emscripten/html5.h>
 
-#include <string>
+#include <string_view>
 
 #include "../models/GameState.hpp"
 
-void onKeyDown(GameState* state, const std::string& key_code);
+void onKeyDown(GameState* state, std::string_view key_code, double key_time);
 void onMouseDown(GameState* state);
 void onMouseUp(GameState* state);
 void onMouseMove(GameState* state, Point2D mouse_pos);
+
+// rotates cube by mouse offset since previous frame
+void applyMouseMoveLoop(GameState* state);
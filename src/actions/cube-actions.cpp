@@ -1,82 +1,93 @@
 #include "cube-actions.hpp"
 
-#include <emscripten.h>
-
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
-const Range AUTO_ROTATION_STEP_RANGE{0.5, 10};
-const Range AUTO_ROTATION_ANGLE_RANGE{0, 180};
+#include "../helpers/graphics-math.hpp"
+
+// all camera speeds are per second, so camera moves the same regardless of
+// frame rate
+const Degrees OVERVIEW_ROTATION_SPEED = 18;
+
+// time for camera to cover ~63% of the way to target orientation. camera
+// slows down when approaching target, but never slower than minimal speed, so
+// it does not crawl the last few degrees
+const double AUTO_ROTATION_TIME_CONSTANT = 0.3;
+const Degrees AUTO_ROTATION_MIN_SPEED = 30;
+
+// camera is considered at rest when it is that close to target orientation
+const Degrees AUTO_ROTATION_SETTLE_ANGLE = 0.05;
+
+// do not jump through half of the rotation after long pause between frames
+// (eg. when browser tab was in background)
+const Cube::duration_ms MAX_ROTATION_TIME_STEP{100};
 
 void autoRotateLoop(GameState* state) {
   auto& cube = state->scene.cube;
 
-  auto& current_rotation = cube.current_rotation;
+  const auto now = std::chrono::steady_clock::now();
+  const auto time_step =
+      std::min(cube.last_rotation_time.has_value()
+                   ? Cube::duration_ms{now - cube.last_rotation_time.value()}
+                   : Cube::duration_ms{0},
+               MAX_ROTATION_TIME_STEP);
+  const auto seconds = time_step.count() / 1000;
+
+  cube.last_rotation_time = now;
+
   auto& target_rotation = cube.target_rotation;
 
   if (cube.camera_mode == ECameraMode::Overview) {
-    target_rotation.y = normalizeDegrees(target_rotation.y - 0.3);
+    target_rotation.y =
+        normalizeDegrees(target_rotation.y - OVERVIEW_ROTATION_SPEED * seconds);
+    cube.target_orientation = getQuaternionForRotation(target_rotation);
   }
 
   if (cube.camera_mode == ECameraMode::FollowSnake) {
+    // recalculate target only when snake head actually moves
     const auto& head = state->snake.parts.front();
-    target_rotation = getCubeRotationForPosition(head, cube.grid);
-  }
-
-  if (cube.current_rotation != cube.target_rotation) {
-    cube.needs_redraw = true;
-  }
-
-  if (current_rotation.x != target_rotation.x) {
-    current_rotation.x =
-        makeRotationStep(current_rotation.x, target_rotation.x);
+    if (cube.followed_head != head) {
+      auto& rotation = cube.cell_rotations[getCellIndex(head, cube.grid)];
+      if (!rotation.has_value()) {
+        rotation = getCubeRotationForPosition(head, cube.grid);
+      }
+
+      target_rotation = rotation.value();
+      cube.target_orientation = getQuaternionForRotation(target_rotation);
+      cube.followed_head = head;
+    }
+  } else {
+    cube.followed_head.reset();
   }
 
-  if (current_rotation.y != target_rotation.y) {
-    current_rotation.y =
-        makeRotationStep(current_rotation.y, target_rotation.y);
-  }
-}
-
-auto makeRotationStep(Degrees current_angle, Degrees target_angle) -> Degrees {
-  const auto angle_diff =
-      std::min({std::abs(current_angle - target_angle),
-                std::abs(current_angle - target_angle - 360),
-                std::abs(current_angle - target_angle + 360)});
-
-  if (angle_diff < AUTO_ROTATION_STEP_RANGE[0]) {
-    return target_angle;
-  }
-
-  auto rotation_step = projectToRange(angle_diff, AUTO_ROTATION_ANGLE_RANGE,
-                                      AUTO_ROTATION_STEP_RANGE);
-  auto nextCurrentRotation =
-      current_angle +
-      rotation_step * getRotationDirection(current_angle, target_angle);
-
-  return normalizeDegrees(nextCurrentRotation);
+  rotateCameraToTarget(&cube, seconds);
 }
 
-auto getRotationDirection(Degrees from, Degrees to) -> int {
-  if (from == to) {
-    return 0;
-  }
+void rotateCameraToTarget(Cube* cube, double seconds) {
+  auto& current = cube->current_orientation;
+  const auto& target = cube->target_orientation;
 
-  if (from >= 0 && to >= 0) {
-    return from > to ? -1 : 1;
+  // angle between equal quaternions is not always 0 due to rounding, so
+  // rest is told by camera having reached target exactly
+  if (current == target) {
+    // camera is at rest, nothing to redraw
+    return;
   }
 
-  if (from <= 0 && to <= 0) {
-    return from > to ? -1 : 1;
-  }
+  cube->needs_redraw = true;
 
-  if (from >= 0 && to <= 0) {
-    return (from - to <= 180) ? -1 : 1;
+  const auto angle = radToDeg(getAngleBetweenQuaternions(current, target));
+  if (angle < AUTO_ROTATION_SETTLE_ANGLE) {
+    current = target;
+    return;
   }
 
-  if (from <= 0 && to >= 0) {
-    return (-from + to < 180) ? 1 : -1;
-  }
+  // exponential approach, which is frame rate independent: two frames of
+  // half duration give the same result as one frame of full duration
+  const auto approach = 1 - std::exp(-seconds / AUTO_ROTATION_TIME_CONSTANT);
+  const auto min_approach = AUTO_ROTATION_MIN_SPEED * seconds / angle;
 
-  emscripten_throw_string("unreachable");
+  current = slerp(current, target,
+                  std::min(std::max(approach, min_approach), 1.0));
 }
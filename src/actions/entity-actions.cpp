@@ -0,0 +1,219 @@
+#include "entity-actions.hpp"
+
+#include "../helpers/board.hpp"
+#include "../helpers/cube.hpp"
+#include "../helpers/direction.hpp"
+#include "snake-actions.hpp"
+
+// in snake moves
+const int WANDER_PERIOD = 2;
+const int DECAY_PERIOD = 60;
+
+// apple zone of level can be crowded, so after that many taken cells apple is
+// planted anywhere
+const int APPLE_ZONE_SPAWN_TRIES = 8;
+
+auto getBehaviourPeriod(EEntityBehaviour behaviour) -> int {
+  switch (behaviour) {
+    case EEntityBehaviour::Wander:
+      return WANDER_PERIOD;
+    case EEntityBehaviour::Decay:
+      return DECAY_PERIOD;
+    case EEntityBehaviour::Static:
+      return 0;
+  }
+
+  return 0;
+}
+
+auto getSpawnCell(GameState* state, ECellContent kind) -> std::optional<int> {
+  auto& board = state->board;
+  const auto& level = state->level;
+
+  if (kind == ECellContent::Apple && level.has_value() &&
+      !level->apple_zone_cells.empty()) {
+    const auto& zone = level->apple_zone_cells;
+    std::uniform_int_distribution<std::size_t> dist(0, zone.size() - 1);
+
+    for (int i = 0; i < APPLE_ZONE_SPAWN_TRIES; ++i) {
+      const auto cell_idx = static_cast<int>(zone[dist(board.random_engine)]);
+      if (board.cells[cell_idx] == ECellContent::Empty) {
+        return cell_idx;
+      }
+    }
+  }
+
+  return getRandomFreeCell(&board);
+}
+
+auto spawnEntity(GameState* state, ECellContent kind,
+                 EEntityBehaviour behaviour) -> bool {
+  auto& board = state->board;
+  auto& entities = state->entities;
+  const auto& cube = state->scene.cube;
+
+  const auto cell_idx = getSpawnCell(state, kind);
+  if (!cell_idx.has_value()) {
+    return false;
+  }
+
+  const auto pos = getCubePositionForCellIndex(cell_idx.value(), cube.grid);
+
+  std::uniform_int_distribution<int> direction_dist(
+      0, static_cast<int>(EDirection::Right));
+
+  board.cells_entities[cell_idx.value()] =
+      static_cast<int>(entities.positions.size());
+  entities.positions.push_back(pos);
+  entities.kinds.push_back(kind);
+  entities.behaviours.push_back(behaviour);
+  entities.timers.push_back(getBehaviourPeriod(behaviour));
+  entities.directions.push_back(
+      static_cast<EDirection>(direction_dist(board.random_engine)));
+
+  setBoardCell(&board, cell_idx.value(), kind);
+
+  return true;
+}
+
+void removeEntity(GameState* state, int entity_idx) {
+  auto& board = state->board;
+  auto& entities = state->entities;
+  const auto& cube = state->scene.cube;
+
+  const auto& pos = entities.positions[entity_idx];
+  const auto cell_idx = getCellIndex(pos, cube.grid);
+
+  // cell could be taken already by snake head picking entity up
+  if (board.cells[cell_idx] == entities.kinds[entity_idx]) {
+    setBoardCell(&board, cell_idx, ECellContent::Empty);
+  }
+  board.cells_entities[cell_idx] = -1;
+
+  // move last entity in place of removed one, so arrays stay dense
+  const auto last_entity_idx = static_cast<int>(entities.positions.size()) - 1;
+  if (entity_idx != last_entity_idx) {
+    entities.positions[entity_idx] = entities.positions[last_entity_idx];
+    entities.kinds[entity_idx] = entities.kinds[last_entity_idx];
+    entities.behaviours[entity_idx] = entities.behaviours[last_entity_idx];
+    entities.timers[entity_idx] = entities.timers[last_entity_idx];
+    entities.directions[entity_idx] = entities.directions[last_entity_idx];
+
+    board.cells_entities[getCellIndex(entities.positions[entity_idx],
+                                      cube.grid)] = entity_idx;
+  }
+
+  entities.positions.pop_back();
+  entities.kinds.pop_back();
+  entities.behaviours.pop_back();
+  entities.timers.pop_back();
+  entities.directions.pop_back();
+}
+
+// keeps arrays memory for next round
+void clearEntities(GameState* state) {
+  auto& entities = state->entities;
+
+  entities.positions.clear();
+  entities.kinds.clear();
+  entities.behaviours.clear();
+  entities.timers.clear();
+  entities.directions.clear();
+}
+
+void moveEntity(GameState* state, int entity_idx, const CubePosition& pos) {
+  auto& board = state->board;
+  auto& entities = state->entities;
+  const auto& cube = state->scene.cube;
+
+  auto& entity_pos = entities.positions[entity_idx];
+
+  const auto prev_cell_idx = getCellIndex(entity_pos, cube.grid);
+  setBoardCell(&board, prev_cell_idx, ECellContent::Empty);
+  board.cells_entities[prev_cell_idx] = -1;
+
+  const auto cell_idx = getCellIndex(pos, cube.grid);
+  setBoardCell(&board, cell_idx, entities.kinds[entity_idx]);
+  board.cells_entities[cell_idx] = entity_idx;
+
+  entity_pos = pos;
+}
+
+void wanderEntity(GameState* state, int entity_idx) {
+  auto& entities = state->entities;
+  const auto& grid = state->scene.cube.grid;
+
+  auto& direction = entities.directions[entity_idx];
+  const auto [next_pos, next_direction] = getNextCubePositionAndDirection(
+      entities.positions[entity_idx], direction, grid);
+
+  if (state->board.cells[getCellIndex(next_pos, grid)] !=
+      ECellContent::Empty) {
+    direction = getOppositeDirection(direction);
+    return;
+  }
+
+  moveEntity(state, entity_idx, next_pos);
+  direction = next_direction;
+}
+
+void decayEntity(GameState* state, int entity_idx) {
+  const auto cell_idx =
+      getSpawnCell(state, state->entities.kinds[entity_idx]);
+
+  if (cell_idx.has_value()) {
+    moveEntity(
+        state, entity_idx,
+        getCubePositionForCellIndex(cell_idx.value(), state->scene.cube.grid));
+  }
+}
+
+void updateEntities(GameState* state) {
+  auto& entities = state->entities;
+
+  // entities only move here, none is added or removed
+  for (std::size_t i = 0; i < entities.behaviours.size(); ++i) {
+    const auto behaviour = entities.behaviours[i];
+    if (behaviour == EEntityBehaviour::Static) {
+      continue;
+    }
+
+    auto& timer = entities.timers[i];
+    timer -= 1;
+    if (timer > 0) {
+      continue;
+    }
+
+    timer = getBehaviourPeriod(behaviour);
+
+    if (behaviour == EEntityBehaviour::Wander) {
+      wanderEntity(state, static_cast<int>(i));
+    } else if (behaviour == EEntityBehaviour::Decay) {
+      decayEntity(state, static_cast<int>(i));
+    }
+  }
+}
+
+void pickUpEntity(GameState* state, int entity_idx) {
+  const auto kind = state->entities.kinds[entity_idx];
+  const auto behaviour = state->entities.behaviours[entity_idx];
+
+  removeEntity(state, entity_idx);
+
+  switch (kind) {
+    case ECellContent::Apple:
+      growSnake(state);
+      if (state->config.respawn_apples) {
+        spawnEntity(state, kind, behaviour);
+      }
+      break;
+    case ECellContent::SlowDown:
+      slowDownSnake(state);
+      spawnEntity(state, kind, behaviour);
+      break;
+    case ECellContent::Empty:
+    case ECellContent::Snake:
+    case ECellContent::Stone:
+      break;
+  }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../models/CubePosition.hpp"
+#include "../models/ECellContent.hpp"
+#include "../models/EEntityBehaviour.hpp"
+#include "../models/GameState.hpp"
+
+// places entity on random free cell. returns false when there is no free cell
+auto spawnEntity(GameState* state, ECellContent kind,
+                 EEntityBehaviour behaviour) -> bool;
+void removeEntity(GameState* state, int entity_idx);
+void clearEntities(GameState* state);
+void moveEntity(GameState* state, int entity_idx, const CubePosition& pos);
+
+// movement system. runs behaviours of all entities, once per snake move
+void updateEntities(GameState* state);
+
+// collision system. applies effect of entity snake head ran into
+void pickUpEntity(GameState* state, int entity_idx);
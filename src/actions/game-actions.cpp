@@ -1,17 +1,30 @@
 #include "game-actions.hpp"
 
 #include <algorithm>
-#include <set>
+#include <array>
+#include <memory>
+#include <tuple>
 #include <vector>
 
+#include "../helpers/allocations.hpp"
+#include "../helpers/board.hpp"
 #include "../helpers/cube.hpp"
+#include "../helpers/distance-field.hpp"
+#include "../helpers/key-bindings.hpp"
 #include "cube-actions.hpp"
+#include "entity-actions.hpp"
 #include "snake-actions.hpp"
+#include "snapshot-actions.hpp"
 
-const int APPLES_COUNT = 10;
-const int STONES_COUNT = 10;
+// cells ahead of snake start kept free of objects
+const int SAFE_START_CELLS_COUNT = 3;
+
+// how far back practice mode takes snake after crash, in snake moves
+const int CRASH_REWIND_TICKS_COUNT = 5;
 
 void initGameState(GameState* state) {
+  state->key_bindings = getDefaultKeyBindings();
+
   state->status = EGameStatus::Welcome;
   plantObjects(state);
 }
@@ -23,65 +36,166 @@ void updateGameStateLoop(GameState* state) {
   auto& cube = state->scene.cube;
 
   if (state->status == EGameStatus::InGame) {
+    if (state->snake.is_crashed && state->config.rewind_on_crash) {
+      const auto& snapshots = state->snapshots;
+      restoreSnapshot(state,
+                      std::max(snapshots.first_tick,
+                               snapshots.tick - CRASH_REWIND_TICKS_COUNT));
+
+      // turns which led to crash are not played again
+      state->snake.pending_turns.clear();
+
+      state->status = EGameStatus::Paused;
+      cube.camera_mode = ECameraMode::Overview;
+    }
+
     if (state->snake.is_crashed) {
       state->status = EGameStatus::Fail;
       cube.camera_mode = ECameraMode::Overview;
-      std::for_each(cube.sides.begin(), cube.sides.end(),
-                    [](std::pair<const ECubeSide, CubeSide>& p) {
-                      p.second.needs_redraw = true;
-                    });
     }
 
-    if (state->apples.empty()) {
+    if (state->board.apples_count == 0) {
       state->status = EGameStatus::Win;
       cube.camera_mode = ECameraMode::Overview;
-      std::for_each(cube.sides.begin(), cube.sides.end(),
-                    [](std::pair<const ECubeSide, CubeSide>& p) {
-                      p.second.needs_redraw = true;
-                    });
     }
   }
 }
 
 void plantObjects(GameState* state) {
-  auto& scene = state->scene;
+  auto& cube = state->scene.cube;
+  const auto& config = state->config;
 
-  std::set<CubePosition> object_positions;
+  state->level = state->next_level;
+  const auto& level = state->level;
 
-  // plant snake
-  state->snake = Snake{};
-  object_positions.insert(*state->snake.parts.begin());
+  // apply grid size of new round
+  const int grid_size =
+      level.has_value() ? level->header->grid_size : config.grid_size;
+  const Grid grid{.rows_count = grid_size, .cols_count = grid_size};
+  if (cube.grid != grid) {
+    cube.grid = grid;
+    cube.cell_rotations.assign(getCellsCount(grid), std::nullopt);
+    cube.followed_head.reset();
+  }
+
+  if (state->cube_graph.grid != grid) {
+    buildCubeGraph(&state->cube_graph, grid);
+  }
+
+  // reclaim memory of previous round at once. clearing snake only puts its
+  // nodes back to arena, it does not touch global heap
+  state->snake.parts.clear();
+  state->round_arena.reset();
 
-  // plant apples
-  state->apples.clear();
+  clearEntities(state);
 
-  while (state->apples.size() < APPLES_COUNT) {
-    auto pos = getRandomCubePosition(scene.cube);
+  // reuse parts list, since it is bound to round arena
+  state->snake = Snake{.parts = std::move(state->snake.parts)};
 
-    // do not plant above other objects
-    if (object_positions.count(pos) == 0) {
-      state->apples.insert(pos);
-      object_positions.insert(pos);
+  if (level.has_value()) {
+    plantLevelObjects(state, level.value());
+  } else {
+    plantRandomObjects(state);
+  }
+
+  // these are not part of levels, so they come from config either way
+  const auto spawn = [state](int count, ECellContent kind,
+                             EEntityBehaviour behaviour) {
+    for (int i = 0; i < count; ++i) {
+      spawnEntity(state, kind, behaviour);
     }
+  };
+
+  spawn(config.decaying_apples_count, ECellContent::Apple,
+        EEntityBehaviour::Decay);
+  spawn(config.slow_downs_count, ECellContent::SlowDown,
+        EEntityBehaviour::Static);
+  spawn(config.wandering_stones_count, ECellContent::Stone,
+        EEntityBehaviour::Wander);
+
+  for (auto& [type, side] : cube.sides) {
+    side.needs_redraw = true;
   }
 
-  // plant stones
-  state->stones.clear();
+  resetSnapshots(state);
+}
 
-  while (state->stones.size() < STONES_COUNT) {
-    auto pos = getRandomCubePosition(scene.cube);
+void plantRandomObjects(GameState* state) {
+  auto& board = state->board;
+  const auto& config = state->config;
+  const auto& grid = state->scene.cube.grid;
 
-    if (object_positions.count(pos) == 0) {
-      state->stones.insert(pos);
-      object_positions.insert(pos);
-    }
+  resetBoard(&board, getCellsCount(grid));
+
+  // plant snake
+  const CubePosition start{ECubeSide::Front, 0, 0};
+  state->snake.parts.push_back(start);
+  setBoardCell(&board, getCellIndex(start, grid), ECellContent::Snake);
+
+  // keep a few cells ahead of snake free, so it does not crash right after
+  // start on dense boards. they are taken while planting only
+  std::array<int, SAFE_START_CELLS_COUNT> safe_cells{};
+  auto pos = start;
+  auto direction = state->snake.direction;
+  for (auto& cell_idx : safe_cells) {
+    std::tie(pos, direction) =
+        getNextCubePositionAndDirection(pos, direction, grid);
+    cell_idx = getCellIndex(pos, grid);
+    setBoardCell(&board, cell_idx, ECellContent::Snake);
   }
 
-  for (auto& [type, side] : scene.cube.sides) {
-    side.needs_redraw = true;
+  for (int i = 0; i < config.apples_count; ++i) {
+    spawnEntity(state, ECellContent::Apple, EEntityBehaviour::Static);
+  }
+
+  const auto stones_count =
+      config.stones_density > 0
+          ? static_cast<int>(config.stones_density * getCellsCount(grid))
+          : config.stones_count;
+  for (int i = 0; i < stones_count; ++i) {
+    plantStone(state);
+  }
+
+  for (const auto cell_idx : safe_cells) {
+    setBoardCell(&board, cell_idx, ECellContent::Empty);
+  }
+}
+
+// level is used in place: stones layout goes to board in one pass, apples are
+// planted in level apple zones
+void plantLevelObjects(GameState* state, const Level& level) {
+  auto& board = state->board;
+  const auto& grid = state->scene.cube.grid;
+  const auto& header = *level.header;
+
+  resetBoard(&board, level.cells);
+
+  const CubePosition start{.side = static_cast<ECubeSide>(header.snake_side),
+                           .row = header.snake_row,
+                           .col = header.snake_col};
+  state->snake.direction = static_cast<EDirection>(header.snake_direction);
+  state->snake.parts.push_back(start);
+  setBoardCell(&board, getCellIndex(start, grid), ECellContent::Snake);
+
+  for (uint32_t i = 0; i < header.apples_count; ++i) {
+    spawnEntity(state, ECellContent::Apple, EEntityBehaviour::Static);
   }
 }
 
+// fixed stones are part of board only, so they cost nothing while round goes
+auto plantStone(GameState* state) -> bool {
+  auto& board = state->board;
+
+  const auto cell_idx = getRandomFreeCell(&board);
+  if (!cell_idx.has_value()) {
+    return false;
+  }
+
+  setBoardCell(&board, cell_idx.value(), ECellContent::Stone);
+
+  return true;
+}
+
 void startOrPauseGame(GameState* state) {
   switch (state->status) {
     case EGameStatus::Welcome:
@@ -103,8 +217,47 @@ void startOrPauseGame(GameState* state) {
   } else {
     state->scene.cube.camera_mode = ECameraMode::Overview;
   }
+}
 
-  for (auto& [type, side] : state->scene.cube.sides) {
-    side.needs_redraw = true;
+auto countSteadyStateAllocations(const GameConfig& config, int ticks_count)
+    -> AllocationCount {
+  // play on scratch state, so real game is not affected. drawing is left
+  // out, since it needs canvases; it is accounted per frame at runtime
+  auto state = std::make_unique<GameState>();
+  state->config = config;
+  initGameState(state.get());
+  startOrPauseGame(state.get());
+
+  // each turn is perpendicular to previous one, so none of them is ignored
+  constexpr std::array TURNS{EDirection::Up, EDirection::Left,
+                             EDirection::Down, EDirection::Right};
+  constexpr int TICKS_PER_TURN = 5;
+
+  const auto tick = [&state, &TURNS](int tick_idx) {
+    if (tick_idx % TICKS_PER_TURN == 0) {
+      const auto turn_idx = (tick_idx / TICKS_PER_TURN) % TURNS.size();
+      queueSnakeTurn(state.get(), TURNS.at(turn_idx), 0);
+    }
+
+    playTick(state.get());
+    autoRotateLoop(state.get());
+
+    // start new round right away, so round reset is checked too
+    if (state->snake.is_crashed || state->board.apples_count == 0) {
+      plantObjects(state.get());
+    }
+  };
+
+  // first ticks may grow round arena, which is fine as long as it settles
+  constexpr int WARM_UP_TICKS_COUNT = 100;
+  for (int i = 0; i < WARM_UP_TICKS_COUNT; ++i) {
+    tick(i);
   }
+
+  const auto start = getAllocationCount();
+  for (int i = 0; i < ticks_count; ++i) {
+    tick(i);
+  }
+
+  return getAllocationCountSince(start);
 }
@@ -1,8 +1,15 @@
 #pragma once
 
+#include "../models/AllocationStats.hpp"
 #include "../models/GameState.hpp"
+#include "../models/Level.hpp"
 
 void initGameState(GameState* state);
 void updateGameStateLoop(GameState* state);
 void plantObjects(GameState* state);
-void startOrPauseGame(GameState* state);
\ No newline at end of file
+void plantRandomObjects(GameState* state);
+void plantLevelObjects(GameState* state, const Level& level);
+auto plantStone(GameState* state) -> bool;
+void startOrPauseGame(GameState* state);
+auto countSteadyStateAllocations(const GameConfig& config, int ticks_count)
+    -> AllocationCount;
\ No newline at end of file
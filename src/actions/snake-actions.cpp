@@ -1,12 +1,24 @@
 #include "snake-actions.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
+#include "../helpers/board.hpp"
 #include "../helpers/cube.hpp"
 #include "../helpers/direction.hpp"
+#include "../helpers/distance-field.hpp"
+#include "../helpers/input-trace.hpp"
+#include "../platform/platform.hpp"
+#include "entity-actions.hpp"
+#include "snapshot-actions.hpp"
 
 const double SNAKE_MOVE_PERIOD_MULTIPLIER = 0.05;  // higher is faster
 const bool MOVE_SNAKE = true;                      // for debug
+const bool AUTOPILOT = false;                      // for debug
+
+// slow down power-up takes back that many speed ups
+const int SLOW_DOWN_SPEED_UPS_COUNT = 3;
 
 void moveSnakeLoop(GameState* state) {
   auto& snake = state->snake;
@@ -16,77 +28,139 @@ void moveSnakeLoop(GameState* state) {
   if (MOVE_SNAKE && state->status == EGameStatus::InGame &&
       (!snake.last_move_time.has_value() ||
        now - snake.last_move_time.value() >= snake.move_period)) {
-    moveSnake(state);
+    if (AUTOPILOT) {
+      steerToNearestApple(state);
+    }
+
+    playTick(state);
     snake.last_move_time = now;
   }
 }
 
 void moveSnake(GameState* state) {
-  auto& scene = state->scene;
+  const auto& scene = state->scene;
   auto& snake = state->snake;
+  auto& board = state->board;
+  const auto& grid = scene.cube.grid;
+
+  const auto turn = applyNextSnakeTurn(state);
 
-  // instead of moving each snake part one step ahead, move tail to new head
   const auto head = snake.parts.front();
   const auto tail = snake.parts.back();
 
-  scene.cube.sides[tail.side].needs_redraw = true;
+  // instead of moving each snake part one step ahead, move tail to new head
   snake.parts.pop_back();
 
+  // snake grows by doubling its tail, so cell is left by its last part only.
+  // cell can also be a stone snake has crashed on
+  const auto tail_cell_idx = getCellIndex(tail, grid);
+  if ((snake.parts.empty() || snake.parts.back() != tail) &&
+      board.cells[tail_cell_idx] == ECellContent::Snake) {
+    setBoardCell(&board, tail_cell_idx, ECellContent::Empty);
+  }
+
   auto [newHead, newDirection] =
-      getNextCubePositionAndDirection(head, snake.direction, scene.cube.grid);
+      getNextCubePositionAndDirection(head, snake.direction, grid);
 
   snake.parts.push_front(newHead);
   snake.direction = newDirection;
 
-  scene.cube.sides[newHead.side].needs_redraw = true;
+  // replayed turns were traced when they were played first
+  if (turn.has_value() && !state->snapshots.is_replaying) {
+    startInputTrace(&state->stats, turn->key_time, newHead.side);
+  }
+
+  // take head cell before picking up, so apple is not respawned under the
+  // head. stone is left on board to be seen, game is over anyway
+  const auto head_cell_idx = getCellIndex(newHead, grid);
+  const auto head_cell = board.cells[head_cell_idx];
+  const auto head_entity_idx = board.cells_entities[head_cell_idx];
+  if (head_cell != ECellContent::Stone) {
+    setBoardCell(&board, head_cell_idx, ECellContent::Snake);
+
+    if (head_entity_idx >= 0) {
+      pickUpEntity(state, head_entity_idx);
+    }
+  }
+
+  checkCrash(state, head_cell);
+
+  updateEntities(state);
+}
+
+// follows apple distance field. does not look out for snake itself
+void steerToNearestApple(GameState* state) {
+  auto& field = state->apple_distances;
+  syncDistanceField(&field, state->cube_graph, state->board);
+
+  const auto head_idx =
+      getCellIndex(state->snake.parts.front(), state->cube_graph.grid);
+  const auto distance = field.distances[head_idx];
 
-  checkForApple(state);
-  checkCrash(state);
+  if (distance > 0 && distance != DistanceField::UNREACHABLE &&
+      state->snake.pending_turns.empty()) {
+    queueSnakeTurn(state, field.directions[head_idx], getNow());
+  }
 }
 
-void setSnakeDirection(GameState* state, EDirection direction) {
-  if (state->snake.direction == getOppositeDirection(direction)) {
+void queueSnakeTurn(GameState* state, EDirection direction, double key_time) {
+  auto& snake = state->snake;
+
+  // validate against direction snake will have after all queued turns applied
+  const auto last_direction = snake.pending_turns.empty()
+                                  ? snake.direction
+                                  : snake.pending_turns.back().direction;
+
+  // ignore turns which do not change direction, so they do not waste moves
+  if (direction == last_direction ||
+      direction == getOppositeDirection(last_direction)) {
     return;
   }
 
-  state->snake.direction = direction;
+  // drop turn if queue is full. player is pressing keys faster than snake
+  // moves, so latest turns are less likely to be intended
+  snake.pending_turns.push({.direction = direction, .key_time = key_time});
 }
 
-void checkForApple(GameState* state) {
+auto applyNextSnakeTurn(GameState* state) -> std::optional<SnakeTurn> {
   auto& snake = state->snake;
-  auto& apples = state->apples;
 
-  const auto& head = snake.parts.front();
-  const auto& tail = snake.parts.back();
-
-  auto it = apples.find(head);
-  if (it != apples.end()) {
-    apples.erase(it);
-    snake.parts.push_back(tail);
+  // direction could have changed since turn was queued (eg. when jumping from
+  // one cube side to another), so validate again against direction in effect
+  // at this move, and skip turns which became invalid
+  while (auto turn = snake.pending_turns.pop()) {
+    if (turn->direction == snake.direction ||
+        turn->direction == getOppositeDirection(snake.direction)) {
+      continue;
+    }
 
-    snake.move_period *= 1 - SNAKE_MOVE_PERIOD_MULTIPLIER;
+    snake.direction = turn->direction;
+    return turn;
   }
+
+  return std::nullopt;
 }
 
-void checkCrash(GameState* state) {
+void growSnake(GameState* state) {
   auto& snake = state->snake;
-  const auto& stones = state->stones;
 
-  const auto& head = snake.parts.front();
+  snake.parts.push_back(snake.parts.back());
+  snake.move_period *= 1 - SNAKE_MOVE_PERIOD_MULTIPLIER;
+}
 
-  // crash on stone
-  if (stones.count(head) > 0) {
-    snake.is_crashed = true;
-  }
+void slowDownSnake(GameState* state) {
+  auto& snake = state->snake;
 
-  // crash on tail
-  if (snake.parts.size() > 3) {
-    auto it = std::next(snake.parts.begin(), 3);
-    for (; it != snake.parts.end(); ++it) {
-      if (*it == head) {
-        snake.is_crashed = true;
-        break;
-      }
-    }
+  // but not slower than at start
+  snake.move_period = std::min(
+      snake.move_period / std::pow(1 - SNAKE_MOVE_PERIOD_MULTIPLIER,
+                                   SLOW_DOWN_SPEED_UPS_COUNT),
+      Snake::INITIAL_MOVE_PERIOD);
+}
+
+void checkCrash(GameState* state, ECellContent head_cell) {
+  // crash on stone or on any part of snake itself
+  if (head_cell == ECellContent::Stone || head_cell == ECellContent::Snake) {
+    state->snake.is_crashed = true;
   }
-}
\ No newline at end of file
+}
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <optional>
+
+#include "../models/ECellContent.hpp"
 #include "../models/GameState.hpp"
+#include "../models/SnakeTurn.hpp"
 
 void moveSnakeLoop(GameState* state);
 void moveSnake(GameState* state);
-void setSnakeDirection(GameState* state, EDirection direction);
-void checkForApple(GameState* state);
-void checkCrash(GameState* state);
+void steerToNearestApple(GameState* state);
+void queueSnakeTurn(GameState* state, EDirection direction, double key_time);
+auto applyNextSnakeTurn(GameState* state) -> std::optional<SnakeTurn>;
+void growSnake(GameState* state);
+void slowDownSnake(GameState* state);
+void checkCrash(GameState* state, ECellContent head_cell);
@@ -0,0 +1,189 @@
+#include "snapshot-actions.hpp"
+
+#include <algorithm>
+
+#include "../helpers/assert.hpp"
+#include "../helpers/board.hpp"
+#include "../helpers/cube.hpp"
+#include "snake-actions.hpp"
+
+// board changes journal is sized for that many changes per tick on top of
+// two per entity: snake takes head cell and frees tail cell, picked up entity
+// frees its cell and respawns
+const int BASE_BOARD_CHANGES_PER_TICK = 8;
+
+auto getKeyframe(Snapshots* snapshots, int tick) -> SnapshotKeyframe& {
+  return snapshots->keyframes.at(tick / Snapshots::KEYFRAME_INTERVAL %
+                                 Snapshots::KEYFRAMES_COUNT);
+}
+
+auto getDelta(Snapshots* snapshots, int tick) -> SnapshotDelta& {
+  return snapshots->deltas.at(tick % Snapshots::DELTAS_COUNT);
+}
+
+void takeKeyframe(GameState* state) {
+  auto& snapshots = state->snapshots;
+  const auto& snake = state->snake;
+
+  auto& keyframe = getKeyframe(&snapshots, snapshots.tick);
+  keyframe.tick = snapshots.tick;
+
+  keyframe.snake_direction = snake.direction;
+  keyframe.pending_turns = snake.pending_turns;
+  keyframe.move_period = snake.move_period;
+  keyframe.is_crashed = snake.is_crashed;
+  keyframe.random_engine = state->board.random_engine;
+
+  // copy assignment reuses capacity, so it does not allocate once reserved
+  keyframe.entities = state->entities;
+
+  // this keyframe took the slot of the oldest one
+  snapshots.first_tick = std::max(
+      snapshots.first_tick,
+      snapshots.tick -
+          (Snapshots::KEYFRAMES_COUNT - 1) * Snapshots::KEYFRAME_INTERVAL);
+}
+
+void restoreKeyframe(GameState* state, const SnapshotKeyframe& keyframe) {
+  auto& snake = state->snake;
+  auto& board = state->board;
+  auto& entities = state->entities;
+  const auto& grid = state->scene.cube.grid;
+
+  snake.direction = keyframe.snake_direction;
+  snake.pending_turns = keyframe.pending_turns;
+  snake.move_period = keyframe.move_period;
+  snake.is_crashed = keyframe.is_crashed;
+  board.random_engine = keyframe.random_engine;
+
+  // entities map is only set on entity cells, so it is updated for entities
+  // which are left and restored
+  for (const auto& pos : entities.positions) {
+    board.cells_entities[getCellIndex(pos, grid)] = -1;
+  }
+
+  entities = keyframe.entities;
+
+  for (std::size_t i = 0; i < entities.positions.size(); ++i) {
+    board.cells_entities[getCellIndex(entities.positions[i], grid)] =
+        static_cast<int>(i);
+  }
+}
+
+void playTick(GameState* state) {
+  auto& snapshots = state->snapshots;
+  auto& board = state->board;
+  const auto& snake = state->snake;
+
+  const auto parts_count = snake.parts.size();
+
+  SnapshotDelta delta{.pending_turns = snake.pending_turns,
+                      .snake_tail = snake.parts.back(),
+                      .board_changes_start = board.changes_count};
+
+  moveSnake(state);
+
+  delta.snake_growth = static_cast<int>(snake.parts.size() - parts_count);
+  delta.board_changes_end = board.changes_count;
+
+  snapshots.tick += 1;
+  getDelta(&snapshots, snapshots.tick) = delta;
+
+  if (snapshots.tick % Snapshots::KEYFRAME_INTERVAL == 0) {
+    takeKeyframe(state);
+  }
+
+  // journal keeps changes of all ticks which can be restored
+  ASSERT(board.changes_count -
+             getDelta(&snapshots, snapshots.first_tick + 1)
+                 .board_changes_start <=
+         static_cast<int64_t>(board.changes.size()));
+}
+
+// reverts tick which took state to this tick
+void undoTick(GameState* state) {
+  auto& snapshots = state->snapshots;
+  auto& board = state->board;
+  auto& parts = state->snake.parts;
+
+  const auto& delta = getDelta(&snapshots, snapshots.tick);
+  const auto changes_size = static_cast<int64_t>(board.changes.size());
+
+  for (auto i = delta.board_changes_end - 1; i >= delta.board_changes_start;
+       --i) {
+    undoBoardChange(&board, board.changes[i % changes_size]);
+  }
+  board.changes_count = delta.board_changes_start;
+
+  for (int i = 0; i < delta.snake_growth; ++i) {
+    parts.pop_back();
+  }
+  parts.pop_front();
+  parts.push_back(delta.snake_tail);
+
+  snapshots.tick -= 1;
+}
+
+void resetSnapshots(GameState* state) {
+  auto& snapshots = state->snapshots;
+  auto& board = state->board;
+  const auto entities_count = state->entities.positions.size();
+
+  // entities are not added while round goes
+  for (auto& keyframe : snapshots.keyframes) {
+    keyframe.tick = -1;
+    keyframe.entities.positions.reserve(entities_count);
+    keyframe.entities.kinds.reserve(entities_count);
+    keyframe.entities.behaviours.reserve(entities_count);
+    keyframe.entities.timers.reserve(entities_count);
+    keyframe.entities.directions.reserve(entities_count);
+  }
+
+  // journal only grows, so rounds after the biggest one do not allocate
+  const auto changes_size =
+      Snapshots::DELTAS_COUNT *
+      (BASE_BOARD_CHANGES_PER_TICK + 2 * entities_count);
+  if (board.changes.size() < changes_size) {
+    board.changes.resize(changes_size);
+  }
+
+  snapshots.tick = 0;
+  snapshots.first_tick = 0;
+
+  takeKeyframe(state);
+}
+
+auto restoreSnapshot(GameState* state, int tick) -> bool {
+  auto& snapshots = state->snapshots;
+
+  if (tick < snapshots.first_tick || tick > snapshots.tick) {
+    return false;
+  }
+
+  const auto keyframe_tick = tick - tick % Snapshots::KEYFRAME_INTERVAL;
+  const auto& keyframe = getKeyframe(&snapshots, keyframe_tick);
+  ASSERT(keyframe.tick == keyframe_tick);
+
+  while (snapshots.tick > keyframe_tick) {
+    undoTick(state);
+  }
+
+  restoreKeyframe(state, keyframe);
+
+  // replay ticks from keyframe with turns queued at that time. they are
+  // recorded again, the same way as the first time
+  snapshots.is_replaying = true;
+  while (snapshots.tick < tick) {
+    state->snake.pending_turns =
+        getDelta(&snapshots, snapshots.tick + 1).pending_turns;
+    playTick(state);
+  }
+  snapshots.is_replaying = false;
+
+  // any cell could have changed
+  for (auto& [type, side] : state->scene.cube.sides) {
+    side.needs_redraw = true;
+  }
+
+  return true;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../models/GameState.hpp"
+
+// starts recording new round. to be called once round is planted
+void resetSnapshots(GameState* state);
+
+// moves snake one step and records the move
+void playTick(GameState* state);
+
+// brings simulation back to given tick of current round. later ticks are
+// dropped, so round goes on from there. returns false when tick is not kept
+// anymore
+auto restoreSnapshot(GameState* state, int tick) -> bool;
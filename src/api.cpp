@@ -0,0 +1,323 @@
+#include "api.hpp"
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "actions/game-actions.hpp"
+#include "actions/snapshot-actions.hpp"
+#include "helpers/allocations.hpp"
+#include "helpers/assert.hpp"
+#include "helpers/cube.hpp"
+#include "helpers/distance-field.hpp"
+#include "helpers/key-bindings.hpp"
+#include "helpers/level.hpp"
+#include "models/QualityTier.hpp"
+
+// embind can only bind free functions without context, so keep pointer to the
+// game state here
+static GameState* api_state = nullptr;  // NOLINT
+
+// memory of loaded level files, which levels in game state point into. round
+// in progress keeps its level until next round starts, so there can be two
+static std::vector<std::vector<std::byte>> level_files;  // NOLINT
+
+void initApi(GameState* state) { api_state = state; }
+
+auto getHistogramStats(const LatencyHistogram& histogram) -> emscripten::val {
+  auto res = emscripten::val::object();
+
+  res.set("count", histogram.samples_count);
+  res.set("avg", histogram.samples_count > 0
+                     ? histogram.total / histogram.samples_count
+                     : 0);
+  res.set("max", histogram.max);
+
+  // bucket upper bound (ms) to samples count
+  auto buckets = emscripten::val::object();
+  for (size_t i = 0; i < histogram.buckets.size(); ++i) {
+    const auto bound = i < LatencyHistogram::BUCKET_BOUNDS.size()
+                           ? std::to_string(static_cast<int>(
+                                 LatencyHistogram::BUCKET_BOUNDS.at(i)))
+                           : std::string{"inf"};
+    buckets.set(bound, histogram.buckets.at(i));
+  }
+  res.set("buckets", buckets);
+
+  return res;
+}
+
+auto getAllocationCountStats(const AllocationCount& allocations)
+    -> emscripten::val {
+  auto res = emscripten::val::object();
+
+  res.set("count", static_cast<double>(allocations.count));
+  res.set("bytes", static_cast<double>(allocations.bytes));
+
+  return res;
+}
+
+auto getAllocationStats(const AllocationStats& allocations)
+    -> emscripten::val {
+  const auto& last_frame = allocations.last_frame;
+
+  auto last_frame_res = emscripten::val::object();
+  last_frame_res.set("input", getAllocationCountStats(last_frame.input));
+  last_frame_res.set("update", getAllocationCountStats(last_frame.update));
+  last_frame_res.set("cubeDrawing",
+                     getAllocationCountStats(last_frame.cube_drawing));
+
+  auto res = emscripten::val::object();
+  res.set("lastFrame", last_frame_res);
+  res.set("framesWithAllocations", allocations.frames_with_allocations);
+  res.set("total", getAllocationCountStats(getAllocationCount()));
+
+  return res;
+}
+
+auto getQualityStats(const Scene& scene) -> emscripten::val {
+  const auto& governor = scene.frame_governor;
+  const auto& tier = QUALITY_TIERS.at(governor.tier);
+
+  auto res = emscripten::val::object();
+  res.set("tier", governor.tier);
+  res.set("renderScale", tier.render_scale);
+  res.set("msaaSamples", scene.cube.multisample_framebuffer.samples);
+  res.set("avgFrameInterval", governor.avg_frame_interval);
+  res.set("avgFrameWork", governor.avg_frame_work);
+  res.set("frameBudget", governor.frame_budget);
+
+  return res;
+}
+
+auto getGLStateStats(const GLStateCache& gl_state) -> emscripten::val {
+  auto res = emscripten::val::object();
+  res.set("issuedCalls", static_cast<double>(gl_state.issued_calls_count));
+  res.set("filteredCalls", static_cast<double>(gl_state.filtered_calls_count));
+
+  return res;
+}
+
+auto getStartupStats(const StartupTimings& startup) -> emscripten::val {
+  auto res = emscripten::val::object();
+
+  res.set("wasmInstantiate", startup.wasm_instantiate);
+  res.set("contextCreation", startup.context_creation);
+  res.set("shadersCompilation", startup.shaders_compilation);
+  res.set("firstTextureUpload", startup.first_texture_upload);
+  res.set("firstFrame", startup.first_frame);
+  res.set("total", startup.total);
+
+  return res;
+}
+
+void reportStartupTimings(const GameState* state) {
+  emscripten::val::global("console").call<void>(
+      "log", std::string{"startup timings (ms):"},
+      getStartupStats(state->stats.startup));
+}
+
+auto getStats() -> emscripten::val {
+  ASSERT(api_state != nullptr);
+  const auto& stats = api_state->stats;
+
+  auto latency = emscripten::val::object();
+  latency.set("keyToMove", getHistogramStats(stats.key_to_move));
+  latency.set("moveToTextureUpload",
+              getHistogramStats(stats.move_to_texture_upload));
+  latency.set("textureUploadToPresent",
+              getHistogramStats(stats.texture_upload_to_present));
+  latency.set("keyToPresent", getHistogramStats(stats.key_to_present));
+
+  auto res = emscripten::val::object();
+  res.set("frames", stats.frames_count);
+  res.set("startup", getStartupStats(stats.startup));
+  res.set("inputLatency", latency);
+  res.set("allocations", getAllocationStats(stats.allocations));
+  res.set("quality", getQualityStats(api_state->scene));
+  res.set("glState", getGLStateStats(api_state->scene.gl_state));
+
+  return res;
+}
+
+// eg. "Module.bindKey('KeyI', 'turnUp')". returns false for unsupported key
+// code or action name
+auto rebindKey(const std::string& key_code, const std::string& action_name)
+    -> bool {
+  ASSERT(api_state != nullptr);
+
+  const auto action = getKeyActionByName(action_name);
+  if (!action.has_value()) {
+    return false;
+  }
+
+  return bindKey(&api_state->key_bindings, key_code, action.value());
+}
+
+// eg. "Module.setGameConfig({gridSize: 32, stonesDensity: 0.4})". omitted
+// fields are left as they are. applies when next round starts, or right away
+// when game is not started yet. returns false for invalid config
+auto setGameConfig(const emscripten::val& config_update) -> bool {
+  ASSERT(api_state != nullptr);
+
+  auto config = api_state->config;
+
+  const auto update = [&config_update](const char* key, auto* field) {
+    const auto value = config_update[key];
+    if (!value.isUndefined()) {
+      *field = value.as<std::remove_pointer_t<decltype(field)>>();
+    }
+  };
+
+  update("gridSize", &config.grid_size);
+  update("applesCount", &config.apples_count);
+  update("respawnApples", &config.respawn_apples);
+  update("stonesCount", &config.stones_count);
+  update("stonesDensity", &config.stones_density);
+  update("wanderingStonesCount", &config.wandering_stones_count);
+  update("decayingApplesCount", &config.decaying_apples_count);
+  update("slowDownsCount", &config.slow_downs_count);
+  update("rewindOnCrash", &config.rewind_on_crash);
+
+  // leave some room for snake to move
+  constexpr int MIN_GRID_SIZE = 4;
+  constexpr double MAX_STONES_DENSITY = 0.9;
+  if (config.grid_size < MIN_GRID_SIZE || config.grid_size > MAX_GRID_SIZE ||
+      config.apples_count < 0 || config.stones_count < 0 ||
+      config.wandering_stones_count < 0 || config.decaying_apples_count < 0 ||
+      config.slow_downs_count < 0 || config.stones_density < 0 ||
+      config.stones_density > MAX_STONES_DENSITY) {
+    return false;
+  }
+
+  // objects have to fit the grid with the same room left. counts are summed
+  // in 64 bits, so huge ones do not wrap around
+  const auto cells_count = int64_t{6} * config.grid_size * config.grid_size;
+  const auto stones_count =
+      config.stones_density > 0
+          ? static_cast<int64_t>(config.stones_density * cells_count)
+          : int64_t{config.stones_count};
+  const auto objects_count =
+      stones_count + config.apples_count + config.wandering_stones_count +
+      config.decaying_apples_count + config.slow_downs_count;
+  if (objects_count > static_cast<int64_t>(MAX_STONES_DENSITY * cells_count)) {
+    return false;
+  }
+
+  api_state->config = config;
+
+  if (api_state->status == EGameStatus::Welcome) {
+    plantObjects(api_state);
+  }
+
+  return true;
+}
+
+// frees files which neither current nor next level points into anymore
+void releaseUnusedLevelFiles() {
+  const auto is_pointing_into = [](const std::optional<Level>& level,
+                                   const std::vector<std::byte>& file) {
+    return level.has_value() &&
+           static_cast<const void*>(level->header) == file.data();
+  };
+
+  std::erase_if(level_files, [&is_pointing_into](const auto& file) {
+    return !is_pointing_into(api_state->level, file) &&
+           !is_pointing_into(api_state->next_level, file);
+  });
+}
+
+// eg. "Module.loadLevel(await (await fetch('maze.level')).arrayBuffer())".
+// file is copied to wasm memory in one go and used in place from there.
+// applies the same way as config. returns false for malformed file
+auto loadLevel(const emscripten::val& array_buffer) -> bool {
+  ASSERT(api_state != nullptr);
+
+  const auto bytes = emscripten::val::global("Uint8Array").new_(array_buffer);
+  const auto size = bytes["length"].as<std::size_t>();
+
+  std::vector<std::byte> data(size);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  auto* data_begin = reinterpret_cast<uint8_t*>(data.data());
+  emscripten::val(emscripten::typed_memory_view(size, data_begin))
+      .call<void>("set", bytes);
+
+  const auto level = getLevel(data.data(), data.size());
+  if (!level.has_value()) {
+    return false;
+  }
+
+  // vector buffer does not move on move, so level view stays valid
+  level_files.push_back(std::move(data));
+  api_state->next_level = level;
+
+  if (api_state->status == EGameStatus::Welcome) {
+    plantObjects(api_state);
+  }
+
+  releaseUnusedLevelFiles();
+
+  return true;
+}
+
+// back to random planting per config
+void unloadLevel() {
+  ASSERT(api_state != nullptr);
+
+  api_state->next_level.reset();
+
+  if (api_state->status == EGameStatus::Welcome) {
+    plantObjects(api_state);
+  }
+
+  releaseUnusedLevelFiles();
+}
+
+// eg. "Module.rewind(10)" takes snake 10 moves back and pauses the game, also
+// after crash, so it can be replayed. returns false when that move is not kept
+// anymore
+auto rewindGame(int ticks_count) -> bool {
+  ASSERT(api_state != nullptr);
+
+  const auto tick = api_state->snapshots.tick - ticks_count;
+  if (ticks_count < 0 || !restoreSnapshot(api_state, tick)) {
+    return false;
+  }
+
+  if (api_state->status != EGameStatus::Welcome) {
+    api_state->status = EGameStatus::Paused;
+    api_state->scene.cube.camera_mode = ECameraMode::Overview;
+  }
+
+  return true;
+}
+
+// moves snake head needs to reach the nearest apple going around stones, or
+// -1 when no apple can be reached
+auto getNearestAppleDistance() -> int {
+  ASSERT(api_state != nullptr);
+
+  auto& field = api_state->apple_distances;
+  syncDistanceField(&field, api_state->cube_graph, api_state->board);
+
+  const auto head_idx =
+      getCellIndex(api_state->snake.parts.front(), api_state->cube_graph.grid);
+  const auto distance = field.distances[head_idx];
+
+  return distance == DistanceField::UNREACHABLE ? -1 : distance;
+}
+
+EMSCRIPTEN_BINDINGS(api) {
+  emscripten::function("getStats", &getStats);
+  emscripten::function("bindKey", &rebindKey);
+  emscripten::function("setGameConfig", &setGameConfig);
+  emscripten::function("loadLevel", &loadLevel);
+  emscripten::function("unloadLevel", &unloadLevel);
+  emscripten::function("rewind", &rewindGame);
+  emscripten::function("getNearestAppleDistance", &getNearestAppleDistance);
+}
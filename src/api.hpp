@@ -0,0 +1,10 @@
+#pragma once
+
+#include "models/GameState.hpp"
+
+// exposes game functions to js through emscripten module object.
+// eg. "Module.getStats()" in browser console
+void initApi(GameState* state);
+
+// logs startup timings to browser console
+void reportStartupTimings(const GameState* state);
@@ -0,0 +1,265 @@
+#include "cube-drawer-webgl2.hpp"
+
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+
+#include "../../helpers/assert.hpp"
+#include "../../helpers/input-trace.hpp"
+#include "../../helpers/opengl.hpp"
+#include "../../models/QualityTier.hpp"
+#include "../../platform/platform.hpp"
+#include "cube-drawer.hpp"
+#include "geometry/cube-side-quads.hpp"
+#include "shaders.hpp"
+
+const int CUBE_SIDES_COUNT = 6;
+const int CUBE_SIDE_QUAD_VERTICES_COUNT = 6;
+
+// WebGL2 path keeps all vertex state in vertex array object, and all side
+// textures in one texture array with layer per side. it is bound once on init,
+// so drawing a frame only needs to pass matrix and issue one instanced draw
+// call, and updating a side texture does not need to rebind anything
+void initCubeDrawerWebGL2(GameState* state) {
+  auto& scene = state->scene;
+  auto& cube = scene.cube;
+  auto& startup = state->stats.startup;
+
+  auto phase_start = getNow();
+
+  const auto vertex_shader =
+      initShader(GL_VERTEX_SHADER, vertex_webgl2_shader_src);
+  const auto fragment_shader =
+      initShader(GL_FRAGMENT_SHADER, fragment_webgl2_shader_src);
+
+  auto program = initProgram({vertex_shader, fragment_shader});
+  cube.program = program;
+
+  startup.shaders_compilation = getNow() - phase_start;
+
+  useProgram(&scene.gl_state, program);
+
+  cube.matrix_uniform_location = getUniformLocation(program, "u_matrix");
+  cube.grid_size_uniform_location = getUniformLocation(program, "u_grid_size");
+
+  GLuint vertex_array{};
+  glGenVertexArrays(1, &vertex_array);
+  glBindVertexArray(vertex_array);
+  cube.vertex_array = vertex_array;
+
+  // pass buffer with quad corners (per vertex)
+  GLuint quad_corners_buffer{};
+  glGenBuffers(1, &quad_corners_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, quad_corners_buffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(cube_side_quad_corners),
+               cube_side_quad_corners.data(), GL_STATIC_DRAW);
+
+  const auto quad_corner_attr_location =
+      getAttributeLocation(program, "a_quad_corner");
+  glEnableVertexAttribArray(quad_corner_attr_location);
+  glVertexAttribPointer(quad_corner_attr_location,  // index
+                        2,                          // size
+                        GL_FLOAT,                   // type
+                        GL_FALSE,                   // normalize
+                        0,                          // stride
+                        nullptr                     // offset
+  );
+
+  // pass buffer with side geometry (per instance)
+  GLuint side_quads_buffer{};
+  glGenBuffers(1, &side_quads_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, side_quads_buffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(cube_side_quads),
+               cube_side_quads.data(), GL_STATIC_DRAW);
+
+  // each instance consists of 10 x 4-byte floats: side, origin, U, V
+  constexpr GLsizei SIDE_QUAD_STRIDE = 10 * sizeof(GLfloat);
+
+  const std::array<std::pair<const char*, std::pair<GLint, int>>, 4>
+      side_quad_attrs{{
+          // name, (size, offset in floats)
+          {"a_cube_side", {1, 0}},
+          {"a_cube_side_origin", {3, 1}},
+          {"a_cube_side_u", {3, 4}},
+          {"a_cube_side_v", {3, 7}},
+      }};
+
+  for (const auto& [name, layout] : side_quad_attrs) {
+    const auto [size, offset] = layout;
+    const auto location = getAttributeLocation(program, name);
+
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(
+        location, size, GL_FLOAT, GL_FALSE, SIDE_QUAD_STRIDE,
+        reinterpret_cast<void*>(  // NOLINT
+            offset * sizeof(GLfloat)));
+
+    // advance attribute once per instance instead of once per vertex
+    glVertexAttribDivisor(location, 1);
+  }
+
+  // texture array itself is created on first upload, when grid is known
+  glUniform1i(getUniformLocation(program, "u_cube_cells"), 0);
+
+  glGetIntegerv(GL_MAX_SAMPLES, &cube.max_msaa_samples);
+
+  phase_start = getNow();
+
+  // pass texture data for the first time (update later in draw loop)
+  updateCubeTexturesWebGL2(state);
+
+  startup.first_texture_upload = getNow() - phase_start;
+}
+
+// texture array storage is immutable, so on grid change the whole array is
+// recreated
+void allocateCubeTextureArray(GLStateCache* gl_state, Cube* cube) {
+  if (cube->texture_array.has_value()) {
+    deleteTexture(gl_state, cube->texture_array.value());
+  }
+
+  const auto& grid = cube->grid;
+
+  GLuint texture_array{};
+  glGenTextures(1, &texture_array);
+  bindTexture(gl_state, GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, texture_array);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R8, grid.cols_count,
+                 grid.rows_count, CUBE_SIDES_COUNT);
+
+  // texels are cell states, which can not be blended
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+  cube->texture_array = texture_array;
+}
+
+// texture array stays bound to the only texture unit, so uploading cell states
+// needs no rebinding. a snake move uploads a couple of texels
+void updateCubeTexturesWebGL2(GameState* state) {
+  auto& cube = state->scene.cube;
+  const auto& grid = cube.grid;
+  const auto& cells = state->board.cells;
+
+  if (cube.textures_grid != grid) {
+    allocateCubeTextureArray(&state->scene.gl_state, &cube);
+    updateCubeGrid(state);
+  }
+
+  ASSERT(cube.texture_array.has_value());
+
+  const auto cells_per_side = grid.rows_count * grid.cols_count;
+
+  for (auto& [side_type, side] : cube.sides) {
+    if (!side.needs_redraw && side.dirty_cells.empty()) {
+      continue;
+    }
+
+    const auto side_type_index = static_cast<int>(side_type);
+
+    if (side.needs_redraw) {
+      const auto* side_cells = &cells[side_type_index * cells_per_side];
+      glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, side_type_index,
+                      grid.cols_count, grid.rows_count, 1, GL_RED,
+                      GL_UNSIGNED_BYTE, side_cells);
+    } else {
+      for (const auto cell_idx : side.dirty_cells) {
+        const auto side_cell_idx = cell_idx % cells_per_side;
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0,
+                        side_cell_idx % grid.cols_count,
+                        side_cell_idx / grid.cols_count, side_type_index, 1, 1,
+                        1, GL_RED, GL_UNSIGNED_BYTE, &cells[cell_idx]);
+      }
+    }
+
+    side.needs_redraw = false;
+    side.dirty_cells.clear();
+
+    traceTextureUploaded(&state->stats, side_type);
+  }
+}
+
+void drawCubeGeometryWebGL2() {
+  glDrawArraysInstanced(GL_TRIANGLES, 0, CUBE_SIDE_QUAD_VERTICES_COUNT,
+                        CUBE_SIDES_COUNT);
+}
+
+void deleteMultisampleFramebuffer(GLStateCache* gl_state,
+                                  MultisampleFramebuffer* framebuffer) {
+  if (framebuffer->samples == 0) {
+    return;
+  }
+
+  deleteFramebuffer(gl_state, framebuffer->framebuffer);
+  glDeleteRenderbuffers(1, &framebuffer->color_renderbuffer);
+  glDeleteRenderbuffers(1, &framebuffer->depth_renderbuffer);
+
+  *framebuffer = MultisampleFramebuffer{};
+}
+
+void updateMultisampleFramebufferWebGL2(GameState* state, int width,
+                                        int height) {
+  auto& cube = state->scene.cube;
+  auto& gl_state = state->scene.gl_state;
+  auto& framebuffer = cube.multisample_framebuffer;
+
+  const auto& tier = QUALITY_TIERS.at(state->scene.frame_governor.tier);
+  const auto samples = std::min(tier.msaa_samples, cube.max_msaa_samples);
+
+  if (framebuffer.samples == samples &&
+      (samples == 0 ||
+       (framebuffer.width == width && framebuffer.height == height))) {
+    return;
+  }
+
+  deleteMultisampleFramebuffer(&gl_state, &framebuffer);
+
+  if (samples == 0) {
+    return;
+  }
+
+  glGenFramebuffers(1, &framebuffer.framebuffer);
+  bindFramebuffer(&gl_state, GL_FRAMEBUFFER, framebuffer.framebuffer);
+
+  glGenRenderbuffers(1, &framebuffer.color_renderbuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, framebuffer.color_renderbuffer);
+  glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width,
+                                   height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, framebuffer.color_renderbuffer);
+
+  glGenRenderbuffers(1, &framebuffer.depth_renderbuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, framebuffer.depth_renderbuffer);
+  glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples,
+                                   GL_DEPTH_COMPONENT24, width, height);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                            GL_RENDERBUFFER, framebuffer.depth_renderbuffer);
+
+  ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+  framebuffer.samples = samples;
+  framebuffer.width = width;
+  framebuffer.height = height;
+}
+
+void bindCubeFramebufferWebGL2(GLStateCache* gl_state, const Cube& cube) {
+  const auto& framebuffer = cube.multisample_framebuffer;
+  bindFramebuffer(gl_state, GL_FRAMEBUFFER,
+                  framebuffer.samples > 0 ? framebuffer.framebuffer : 0);
+}
+
+void resolveMultisampleFramebufferWebGL2(GLStateCache* gl_state,
+                                         const Cube& cube) {
+  const auto& framebuffer = cube.multisample_framebuffer;
+  if (framebuffer.samples == 0) {
+    return;
+  }
+
+  bindFramebuffer(gl_state, GL_READ_FRAMEBUFFER, framebuffer.framebuffer);
+  bindFramebuffer(gl_state, GL_DRAW_FRAMEBUFFER, 0);
+  glBlitFramebuffer(0, 0, framebuffer.width, framebuffer.height, 0, 0,
+                    framebuffer.width, framebuffer.height, GL_COLOR_BUFFER_BIT,
+                    GL_NEAREST);
+  bindFramebuffer(gl_state, GL_FRAMEBUFFER, 0);
+}
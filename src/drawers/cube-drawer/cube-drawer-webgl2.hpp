@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../../models/GameState.hpp"
+
+void initCubeDrawerWebGL2(GameState* state);
+void updateCubeTexturesWebGL2(GameState* state);
+void drawCubeGeometryWebGL2();
+
+// (re)creates multisampled framebuffer when canvas size or quality tier has
+// changed, or deletes it when tier has no MSAA
+void updateMultisampleFramebufferWebGL2(GameState* state, int width,
+                                        int height);
+
+// multisampled framebuffer when there is one, canvas otherwise
+void bindCubeFramebufferWebGL2(GLStateCache* gl_state, const Cube& cube);
+
+// copies multisampled framebuffer to canvas
+void resolveMultisampleFramebufferWebGL2(GLStateCache* gl_state,
+                                         const Cube& cube);
@@ -1,65 +1,73 @@
 #include "cube-drawer.hpp"
 
 #include <GLES2/gl2.h>
-#include <emscripten/html5_webgl.h>
-#include <emscripten/val.h>
-#include <webgl/webgl1.h>
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 #include <tuple>
 
 #include "../../helpers/assert.hpp"
+#include "../../helpers/input-trace.hpp"
 #include "../../helpers/opengl.hpp"
-#include "../../helpers/utils.hpp"
+#include "../../models/QualityTier.hpp"
+#include "../../platform/platform.hpp"
 #include "geometry/cube-texture-coords.hpp"
+#include "cube-drawer-webgl2.hpp"
 #include "geometry/cube-vertex-coords.hpp"
+#include "shaders.hpp"
 
 constexpr Radians FIELD_OF_VIEW = degToRad(60);
 
-// using GLES2 API to draw 3D since it's basically the same as webgl API.
-// alternatively emscripten has static bindings for webgl (too long func names
-// due to "emscripten_" prefix) or SDL (totally different API)
+// camera looks at the center of unit cube from this distance
+const double CAMERA_DISTANCE = 2;
+const double CUBE_SIZE = 1;
+
+auto getProjectedCubeSideSize(double viewport_height) -> double {
+  // side turned straight to camera is the largest one on screen
+  const auto side_distance = CAMERA_DISTANCE - CUBE_SIZE / 2;
+  const auto visible_height =
+      2 * side_distance * std::tan(FIELD_OF_VIEW / 2);
+
+  return CUBE_SIZE / visible_height * viewport_height;
+}
+
 void initCubeDrawer(GameState* state) {
   auto& scene = state->scene;
+  auto& startup = state->stats.startup;
   ASSERT(scene.canvas.has_value());
 
-  EmscriptenWebGLContextAttributes attrs{
-      .alpha = GL_TRUE,
-      .depth = GL_TRUE,
-      .stencil = GL_FALSE,
-      .antialias = GL_TRUE,
-      .premultipliedAlpha = GL_TRUE,
-      .preserveDrawingBuffer = GL_FALSE,
-      .powerPreference = EM_WEBGL_POWER_PREFERENCE_DEFAULT,
-      .failIfMajorPerformanceCaveat = GL_FALSE};
-
-  auto ctx_handle = emscripten_webgl_create_context("canvas", &attrs);
-  emscripten_webgl_make_context_current(ctx_handle);
-
-  // getting webgl context second time. this time in a form of embind handle, so
-  // later we can use it for dynamic binding. this is ugly. ideally we would use
-  // GLES2 API for everything, but turns out GLES2 API is not suitable for all
-  // possible scenarious. eg. see comment below about using another canvas as a
-  // data source for texture
-  //
-  // anyway getting context multiple times on canvas shouldn't cause any
-  // problems, since web API doc explicitly states that "Later calls to this
-  // method [getContext] on the same canvas element, with the same contextType
-  // argument, will always return the same drawing context instance as was
-  // returned the first time the method was invoked."
-  auto ctx =
-      scene.canvas->call<emscripten::val, std::string>("getContext", "webgl");
-  scene.ctx = ctx;
+  const auto phase_start = getNow();
+
+  auto& cube = scene.cube;
+  cube.webgl_version = createGraphicsContext(scene.canvas.value());
+
+  startup.context_creation = getNow() - phase_start;
+
+  // cell states are one byte per texel, so their rows are not aligned
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+  if (cube.webgl_version == 2) {
+    initCubeDrawerWebGL2(state);
+  } else {
+    initCubeDrawerWebGL1(state);
+  }
+
+  scene.frame_governor.is_msaa_available = cube.max_msaa_samples > 0;
+}
+
+// WebGL1 draws all cube sides with one draw call too, but it needs separate
+// texture unit for each side, and shader selects texture by branching on side
+// index
+void initCubeDrawerWebGL1(GameState* state) {
+  auto& scene = state->scene;
   auto& cube = scene.cube;
+  auto& startup = state->stats.startup;
 
-  // compile GLSL shaders for cube
-  const auto vertex_shader_src =
-      read_file_to_string("src/drawers/cube-drawer/shaders/vertex.glsl");
-  const auto fragment_shader_src =
-      read_file_to_string("src/drawers/cube-drawer/shaders/fragment.glsl");
+  auto phase_start = getNow();
 
+  // compile GLSL shaders for cube. shader sources are embedded into binary at
+  // build time (see CMakeLists.txt)
   const auto vertex_shader = initShader(GL_VERTEX_SHADER, vertex_shader_src);
   const auto fragment_shader =
       initShader(GL_FRAGMENT_SHADER, fragment_shader_src);
@@ -67,7 +75,9 @@ void initCubeDrawer(GameState* state) {
   auto program = initProgram({vertex_shader, fragment_shader});
   scene.cube.program = program;
 
-  glUseProgram(program);
+  startup.shaders_compilation = getNow() - phase_start;
+
+  useProgram(&scene.gl_state, program);
 
   // lookup locations for attributes/uniforms
   auto cube_vertex_coord_attr_location =
@@ -77,6 +87,7 @@ void initCubeDrawer(GameState* state) {
   auto cube_texture_coord_attr_location =
       getAttributeLocation(program, "a_cube_texture_coord");
   cube.matrix_uniform_location = getUniformLocation(program, "u_matrix");
+  cube.grid_size_uniform_location = getUniformLocation(program, "u_grid_size");
 
   // pass buffer with vertex coordinates
   GLuint cube_vertex_coords_buffer{};
@@ -138,82 +149,77 @@ void initCubeDrawer(GameState* state) {
     // bind uniform with texture unit
     const auto side_type_idx = static_cast<int>(side_type);
     const auto uniform_name =
-        "u_cube_texture_side_" + std::to_string(side_type_idx);
+        "u_cube_cells_side_" + std::to_string(side_type_idx);
     GLint cube_texture_side_uniform_location =
         getUniformLocation(program, uniform_name.c_str());
 
     glUniform1i(cube_texture_side_uniform_location, side_type_idx);
+
+    bindTexture(&scene.gl_state, GL_TEXTURE0 + side_type_idx, GL_TEXTURE_2D,
+                texture);
+
+    // texels are cell states, which can not be blended. texture size is not
+    // power of two, so WebGL1 needs clamping and no mipmaps too
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
   }
 
   cube.textures = std::move(cube_textures);
 
-  // pass texture data for the first time (update later in draw loop)
-  for (auto& [side_type, side] : cube.sides) {
-    ASSERT(side.canvas.has_value());
-    ASSERT(side.ctx.has_value());
-    const auto& canvas = side.canvas.value();
-
-    const auto side_type_idx = static_cast<int>(side_type);
-    glActiveTexture(GL_TEXTURE0 + side_type_idx);  // select texture unit
-    glBindTexture(GL_TEXTURE_2D, cube.textures[side_type_idx]);
-
-    // use dynamic binding to webgl API instead of GLES2 API here, because
-    // GLES2 "glTexImage2D" expects pointer to data array "const void *pixels":
-    // (a) it's impossible to get pointer to canvas data and pass it to wasm
-    // function, since canvas data is located in js memory,
-    // (b) js glue expectes pointer to wasm memory only
-    ctx.call<void>("texImage2D",
-                   ctx["TEXTURE_2D"],     // target
-                   0,                     // level
-                   ctx["RGBA"],           // internal format
-                   ctx["RGBA"],           // format
-                   ctx["UNSIGNED_BYTE"],  // type
-                   canvas                 // source
-    );
+  phase_start = getNow();
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  // pass texture data for the first time (update later in draw loop)
+  updateCubeTexturesWebGL1(state);
 
-    side.needs_update_on_cube = false;
-  }
+  startup.first_texture_upload = getNow() - phase_start;
 }
 
 auto shouldRedrawCube(const Cube& cube) -> bool {
   return cube.needs_redraw ||
          std::any_of(cube.sides.begin(), cube.sides.end(),
                      [](const std::pair<ECubeSide, CubeSide>& p) {
-                       return p.second.needs_update_on_cube;
+                       return p.second.needs_redraw ||
+                              !p.second.dirty_cells.empty();
                      });
 }
 
-void drawCubeLoop(GameState* state) {
+auto drawCubeLoop(GameState* state) -> bool {
   ASSERT(state != nullptr);
   ASSERT(state->scene.canvas.has_value());
 
-  const auto& scene = state->scene;
+  auto& scene = state->scene;
   const auto& canvas = scene.canvas.value();
   const auto& cube = scene.cube;
 
   if (!shouldRedrawCube(cube)) {
-    return;
+    return false;
+  }
+
+  const auto canvas_size = getCanvasSize(canvas);
+  const auto width = static_cast<int>(canvas_size.width);
+  const auto height = static_cast<int>(canvas_size.height);
+
+  if (cube.webgl_version == 2) {
+    updateMultisampleFramebufferWebGL2(state, width, height);
+    bindCubeFramebufferWebGL2(&scene.gl_state, cube);
   }
 
   // define how to convert from clip space to canvas pixels
-  glViewport(0, 0, canvas["width"].as<int>(), canvas["height"].as<int>());
+  setViewport(&scene.gl_state, 0, 0, width, height);
 
-  glEnable(GL_CULL_FACE);
-  glEnable(GL_DEPTH_TEST);
+  setCapability(&scene.gl_state, GL_CULL_FACE, true);
+  setCapability(&scene.gl_state, GL_DEPTH_TEST, true);
 
   // clear the canvas and the depth buffer
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
   // calculate transformation matrix
-  const auto aspect =
-      canvas["clientWidth"].as<double>() / canvas["clientHeight"].as<double>();
+  const auto aspect = scene.css_size.width / scene.css_size.height;
   const auto projection_matrix = perspective(FIELD_OF_VIEW, aspect, 1, 2000);
 
-  static const Vec3 camera_position{0, 0, 2};
+  static const Vec3 camera_position{0, 0, CAMERA_DISTANCE};
   static const Vec3 up{0, 1, 0};
   static const Vec3 target{0, 0, 0};
 
@@ -221,60 +227,116 @@ void drawCubeLoop(GameState* state) {
   static const auto view_matrix = inverse(camera_matrix);
   const auto view_projection_matrix = multiply(projection_matrix, view_matrix);
 
-  auto matrix =
-      xRotate(view_projection_matrix, degToRad(cube.current_rotation.x));
-  matrix = yRotate(matrix, degToRad(cube.current_rotation.y));
+  const auto matrix = rotate(view_projection_matrix, cube.current_orientation);
 
   drawCube(state, matrix);
+
+  if (cube.webgl_version == 2) {
+    resolveMultisampleFramebufferWebGL2(&scene.gl_state, cube);
+  }
+
+  return true;
 }
 
 void drawCube(GameState* state, const Matrix4& matrix) {
   ASSERT(state != nullptr);
   ASSERT(state->scene.canvas.has_value());
-  ASSERT(state->scene.ctx.has_value());
 
-  auto& scene = state->scene;
-  auto& cube = scene.cube;
-  const auto& ctx = scene.ctx.value();
+  auto& cube = state->scene.cube;
+  auto& gl_state = state->scene.gl_state;
 
   ASSERT(cube.program.has_value());
-  ASSERT(cube.textures.size() == cube.sides.size());
 
-  glUseProgram(cube.program.value());
+  useProgram(&gl_state, cube.program.value());
 
   // update texture data if needed
-  for (auto& [side_type, side] : cube.sides) {
-    if (side.needs_update_on_cube) {
-      ASSERT(side.canvas.has_value());
-
-      const auto side_type_index = static_cast<int>(side_type);
-      glActiveTexture(GL_TEXTURE0 + side_type_index);  // select texture unit
-      glBindTexture(GL_TEXTURE_2D, cube.textures[side_type_index]);
-
-      ctx.call<void>("texSubImage2D",
-                     ctx["TEXTURE_2D"],     // target
-                     0,                     // level
-                     0,                     // offset x
-                     0,                     // offset y
-                     ctx["RGBA"],           // format
-                     ctx["UNSIGNED_BYTE"],  // type
-                     side.canvas.value()    // source
-      );
-
-      side.needs_update_on_cube = false;
-    }
+  if (cube.webgl_version == 2) {
+    updateCubeTexturesWebGL2(state);
+  } else {
+    updateCubeTexturesWebGL1(state);
   }
 
   // pass transformation matrix
   ASSERT(cube.matrix_uniform_location.has_value());
-  glUniformMatrix4fv(cube.matrix_uniform_location.value(), 1, GL_FALSE,
-                     matrix.data());
+  setUniformMatrix4(&gl_state, cube.matrix_uniform_location.value(), matrix);
 
   // draw the geometry
-  constexpr int CUBE_VERTICES_COUNT = 6     // cube sides
-                                      * 2   // triangles per cube side
-                                      * 3;  // vertices per triangle
-  glDrawArrays(GL_TRIANGLES, 0, CUBE_VERTICES_COUNT);
+  if (cube.webgl_version == 2) {
+    drawCubeGeometryWebGL2();
+  } else {
+    constexpr int CUBE_VERTICES_COUNT = 6     // cube sides
+                                        * 2   // triangles per cube side
+                                        * 3;  // vertices per triangle
+    glDrawArrays(GL_TRIANGLES, 0, CUBE_VERTICES_COUNT);
+  }
 
   cube.needs_redraw = false;
 }
+
+// grid lines are computed from grid size in shader, and textures have texel
+// per cell, so both follow grid
+void updateCubeGrid(GameState* state) {
+  auto& cube = state->scene.cube;
+  const auto& grid = cube.grid;
+
+  ASSERT(cube.grid_size_uniform_location.has_value());
+  glUniform2f(cube.grid_size_uniform_location.value(),
+              static_cast<GLfloat>(grid.cols_count),
+              static_cast<GLfloat>(grid.rows_count));
+
+  // new storage has no cell states yet
+  for (auto& [side_type, side] : cube.sides) {
+    side.needs_redraw = true;
+  }
+
+  cube.textures_grid = grid;
+}
+
+void updateCubeTexturesWebGL1(GameState* state) {
+  auto& cube = state->scene.cube;
+  const auto& grid = cube.grid;
+  const auto& cells = state->board.cells;
+
+  ASSERT(cube.textures.size() == cube.sides.size());
+
+  const auto is_allocation = cube.textures_grid != grid;
+  if (is_allocation) {
+    updateCubeGrid(state);
+  }
+
+  const auto cells_per_side = grid.rows_count * grid.cols_count;
+
+  for (auto& [side_type, side] : cube.sides) {
+    if (!side.needs_redraw && side.dirty_cells.empty()) {
+      continue;
+    }
+
+    const auto side_type_index = static_cast<int>(side_type);
+    bindTexture(&state->scene.gl_state, GL_TEXTURE0 + side_type_index,
+                GL_TEXTURE_2D, cube.textures[side_type_index]);
+
+    const auto* side_cells = &cells[side_type_index * cells_per_side];
+
+    if (is_allocation) {
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, grid.cols_count,
+                   grid.rows_count, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                   side_cells);
+    } else if (side.needs_redraw) {
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, grid.cols_count,
+                      grid.rows_count, GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                      side_cells);
+    } else {
+      for (const auto cell_idx : side.dirty_cells) {
+        const auto side_cell_idx = cell_idx % cells_per_side;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, side_cell_idx % grid.cols_count,
+                        side_cell_idx / grid.cols_count, 1, 1, GL_LUMINANCE,
+                        GL_UNSIGNED_BYTE, &cells[cell_idx]);
+      }
+    }
+
+    side.needs_redraw = false;
+    side.dirty_cells.clear();
+
+    traceTextureUploaded(&state->stats, side_type);
+  }
+}
@@ -3,6 +3,17 @@
 #include "../../helpers/graphics-math.hpp"
 #include "../../models/GameState.hpp"
 
+// on-screen size (px) of cube side facing camera, for viewport of given height
+auto getProjectedCubeSideSize(double viewport_height) -> double;
+
 void initCubeDrawer(GameState* state);
-void drawCubeLoop(GameState* state);
+void initCubeDrawerWebGL1(GameState* state);
+
+// returns whether cube was redrawn
+auto drawCubeLoop(GameState* state) -> bool;
 void drawCube(GameState* state, const Matrix4& matrix);
+
+// passes grid to shader and marks sides for full upload, after side textures
+// are reallocated for new grid
+void updateCubeGrid(GameState* state);
+void updateCubeTexturesWebGL1(GameState* state);
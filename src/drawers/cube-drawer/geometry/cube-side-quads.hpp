@@ -0,0 +1,37 @@
+#pragma once
+
+#include <GLES2/gl2.h>
+
+#include <array>
+
+#include "cube-vertex-coords.hpp"
+
+// same cube geometry as in cube-vertex-coords.hpp and cube-texture-coords.hpp,
+// but in a form which allows to draw all cube sides as instances of one quad.
+// each side is a parallelogram, so any point on it can be described as
+// origin + u * U + v * V, where (u, v) is texture coordinate of that point
+
+// corners of the quad in texture coordinates (u, v). two triangles, with
+// winding which faces outwards of the cube once projected to the side
+static const std::array<GLfloat, 12> cube_side_quad_corners{
+    // clang-format off
+  0, 0,
+  0, 1,
+  1, 0,
+  1, 0,
+  0, 1,
+  1, 1,
+    // clang-format on
+};
+
+// side index, origin (x, y, z), U vector (x, y, z), V vector (x, y, z)
+static const std::array<GLfloat, 60> cube_side_quads{
+    // clang-format off
+  front, -0.5,  0.5,  0.5,    1,  0,  0,    0, -1,  0,
+  back,   0.5,  0.5, -0.5,   -1,  0,  0,    0, -1,  0,
+  up,    -0.5,  0.5, -0.5,    1,  0,  0,    0,  0,  1,
+  down,  -0.5, -0.5,  0.5,    1,  0,  0,    0,  0, -1,
+  left,  -0.5,  0.5, -0.5,    0,  0,  1,    0, -1,  0,
+  right,  0.5,  0.5,  0.5,    0,  0, -1,    0, -1,  0,
+    // clang-format on
+};
@@ -0,0 +1,75 @@
+#version 300 es
+
+// cell coordinates go up to grid size, and grid lines come from their
+// fractions, which mediump does not resolve on bigger grids
+precision highp float;
+precision mediump sampler2DArray;
+
+in vec2 v_cube_texture_coord;
+flat in int v_cube_side;
+
+// cell contents of all cube sides (see ECellContent) in one texture array,
+// texel per cell and layer per side, so texture is selected by side index
+// without branching. side image is computed from it right here, so it is sharp
+// at any grid size and screen resolution
+uniform sampler2DArray u_cube_cells;
+
+// cols, rows
+uniform vec2 u_grid_size;
+
+out vec4 out_color;
+
+const float GRID_LINE_WIDTH = 1.0;  // px
+
+// lines fade out on cells smaller than that (px), so far sides do not turn
+// into moire
+const float MIN_LINED_CELL_SIZE = 4.0;
+
+vec3 getCellColor(float content) {
+  if (content < 0.5) {
+    return vec3(1.0);  // empty
+  }
+  if (content < 1.5) {
+    return vec3(1.0, 0.0, 0.0);  // snake
+  }
+  if (content < 2.5) {
+    return vec3(0.0, 0.5, 0.0);  // apple
+  }
+  if (content < 3.5) {
+    return vec3(0.0);  // stone
+  }
+  return vec3(0.0, 0.0, 1.0);  // slow down
+}
+
+void main() {
+  // row 0 is at the bottom of side image, while texture rows go from the top
+  vec2 cell_coord =
+      vec2(v_cube_texture_coord.x, 1.0 - v_cube_texture_coord.y) * u_grid_size;
+  vec2 cell = clamp(floor(cell_coord), vec2(0.0), u_grid_size - 1.0);
+
+  // derivatives are undefined in branches which differ between neighbour
+  // fragments, so they are taken upfront
+  vec2 cells_per_px = fwidth(cell_coord);
+
+  float content =
+      texelFetch(u_cube_cells, ivec3(cell, v_cube_side), 0).r * 255.0;
+  vec3 color = getCellColor(content);
+
+  // lines go between cells, not along side edges. objects cover lines of
+  // their cells
+  if (content < 0.5) {
+    vec2 line = clamp(floor(cell_coord + 0.5), vec2(1.0), u_grid_size - 1.0);
+    vec2 line_distance = abs(cell_coord - line) / cells_per_px;
+
+    float coverage = clamp(GRID_LINE_WIDTH / 2.0 + 0.5 -
+                               min(line_distance.x, line_distance.y),
+                           0.0, 1.0);
+
+    float cell_size = 1.0 / max(cells_per_px.x, cells_per_px.y);
+    coverage *= clamp(cell_size / MIN_LINED_CELL_SIZE, 0.0, 1.0);
+
+    color *= 1.0 - coverage;
+  }
+
+  out_color = vec4(color, 1.0);
+}
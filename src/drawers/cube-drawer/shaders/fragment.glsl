@@ -1,4 +1,12 @@
+#extension GL_OES_standard_derivatives : enable
+
+// cell coordinates go up to grid size, and grid lines come from their
+// fractions, which mediump does not resolve on bigger grids
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
 precision mediump float;
+#endif
 
 varying vec2 v_cube_texture_coord;
 varying float v_cube_vertex_side;
@@ -14,37 +22,101 @@ varying float v_cube_vertex_side;
 // I guess single-draw approach should be faster, but not 100% sure which one is
 // better overall (performance and code complexity wise)
 // https://stackoverflow.com/questions/7767367/how-to-fill-each-side-of-a-cube-with-different-textures-on-opengl-es-1-1
-uniform sampler2D u_cube_texture_side_0;
-uniform sampler2D u_cube_texture_side_1;
-uniform sampler2D u_cube_texture_side_2;
-uniform sampler2D u_cube_texture_side_3;
-uniform sampler2D u_cube_texture_side_4;
-uniform sampler2D u_cube_texture_side_5;
+//
+// side texture has texel per cell with its content (see ECellContent), and
+// side image is computed from it right here, so it is sharp at any grid size
+// and screen resolution
+uniform sampler2D u_cube_cells_side_0;
+uniform sampler2D u_cube_cells_side_1;
+uniform sampler2D u_cube_cells_side_2;
+uniform sampler2D u_cube_cells_side_3;
+uniform sampler2D u_cube_cells_side_4;
+uniform sampler2D u_cube_cells_side_5;
 
-void main() {
-  // round cube side index. even though side index equals to the same integer
-  // for each vertex of one cube side, and therefore should be the same for each
-  // pixel of that cube side, for some reason it slightly deviates from integer.
-  // most likely because of cumulative floating-point error while interpolating
-  // varying between vertices
-  int side = int(floor(v_cube_vertex_side + 0.5));
+// cols, rows
+uniform vec2 u_grid_size;
+
+const float GRID_LINE_WIDTH = 1.0;  // px
+
+// lines fade out on cells smaller than that (px), so far sides do not turn
+// into moire
+const float MIN_LINED_CELL_SIZE = 4.0;
+
+vec3 getCellColor(float content) {
+  if (content < 0.5) {
+    return vec3(1.0);  // empty
+  }
+  if (content < 1.5) {
+    return vec3(1.0, 0.0, 0.0);  // snake
+  }
+  if (content < 2.5) {
+    return vec3(0.0, 0.5, 0.0);  // apple
+  }
+  if (content < 3.5) {
+    return vec3(0.0);  // stone
+  }
+  return vec3(0.0, 0.0, 1.0);  // slow down
+}
+
+float getCellContent(int side, vec2 texture_coord) {
+  vec4 texel;
 
   if (side == 0) {
-    gl_FragColor = texture2D(u_cube_texture_side_0, v_cube_texture_coord);
+    texel = texture2D(u_cube_cells_side_0, texture_coord);
   } else
   if (side == 1) {
-    gl_FragColor = texture2D(u_cube_texture_side_1, v_cube_texture_coord);
+    texel = texture2D(u_cube_cells_side_1, texture_coord);
   } else
   if (side == 2) {
-    gl_FragColor = texture2D(u_cube_texture_side_2, v_cube_texture_coord);
+    texel = texture2D(u_cube_cells_side_2, texture_coord);
   } else
   if (side == 3) {
-    gl_FragColor = texture2D(u_cube_texture_side_3, v_cube_texture_coord);
+    texel = texture2D(u_cube_cells_side_3, texture_coord);
   } else
   if (side == 4) {
-    gl_FragColor = texture2D(u_cube_texture_side_4, v_cube_texture_coord);
-  } else
-  if (side == 5) {
-    gl_FragColor = texture2D(u_cube_texture_side_5, v_cube_texture_coord);
+    texel = texture2D(u_cube_cells_side_4, texture_coord);
+  } else {
+    texel = texture2D(u_cube_cells_side_5, texture_coord);
   }
+
+  return texel.r * 255.0;
+}
+
+void main() {
+  // round cube side index. even though side index equals to the same integer
+  // for each vertex of one cube side, and therefore should be the same for each
+  // pixel of that cube side, for some reason it slightly deviates from integer.
+  // most likely because of cumulative floating-point error while interpolating
+  // varying between vertices
+  int side = int(floor(v_cube_vertex_side + 0.5));
+
+  // row 0 is at the bottom of side image, while texture rows go from the top
+  vec2 cell_coord =
+      vec2(v_cube_texture_coord.x, 1.0 - v_cube_texture_coord.y) * u_grid_size;
+  vec2 cell = clamp(floor(cell_coord), vec2(0.0), u_grid_size - 1.0);
+
+  // derivatives are undefined in branches which differ between neighbour
+  // fragments, so they are taken upfront
+  vec2 cells_per_px = fwidth(cell_coord);
+
+  float content = getCellContent(side, (cell + 0.5) / u_grid_size);
+  vec3 color = getCellColor(content);
+
+  // lines go between cells, not along side edges. objects cover lines of
+  // their cells
+  if (content < 0.5) {
+    vec2 line = clamp(floor(cell_coord + 0.5), vec2(1.0), u_grid_size - 1.0);
+    vec2 line_distance = abs(cell_coord - line) / cells_per_px;
+
+    float coverage = clamp(GRID_LINE_WIDTH / 2.0 + 0.5 -
+                               min(line_distance.x, line_distance.y),
+                           0.0, 1.0);
+
+    float cell_size = 1.0 / max(cells_per_px.x, cells_per_px.y);
+    coverage *= clamp(cell_size / MIN_LINED_CELL_SIZE, 0.0, 1.0);
+
+    color *= 1.0 - coverage;
+  }
+
+  gl_FragColor = vec4(color, 1.0);
 }
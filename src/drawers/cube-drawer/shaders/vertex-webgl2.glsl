@@ -0,0 +1,27 @@
+#version 300 es
+
+// each cube side is drawn as an instance of the same quad. quad corner comes
+// per vertex, while side geometry comes per instance
+in vec2 a_quad_corner;
+in float a_cube_side;
+in vec3 a_cube_side_origin;
+in vec3 a_cube_side_u;
+in vec3 a_cube_side_v;
+
+uniform mat4 u_matrix;
+
+out vec2 v_cube_texture_coord;
+
+// flat varying is not interpolated between vertices, so side index stays
+// exactly integer
+flat out int v_cube_side;
+
+void main() {
+  vec3 position = a_cube_side_origin + a_quad_corner.x * a_cube_side_u +
+                  a_quad_corner.y * a_cube_side_v;
+
+  gl_Position = u_matrix * vec4(position, 1.0);
+
+  v_cube_texture_coord = a_quad_corner;
+  v_cube_side = int(a_cube_side);
+}
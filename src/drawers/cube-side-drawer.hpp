@@ -1,7 +1,7 @@
 #pragma once
 
-#include "../models/ECubeSide.hpp"
 #include "../models/GameState.hpp"
 
-void initCubeSideDrawer(GameState* state, ECubeSide side);
-void drawCubeSideLoop(GameState* state, ECubeSide cubeSide);
\ No newline at end of file
+// marks cells changed on board since previous frame as dirty on their sides,
+// so cube drawer uploads only them
+void collectDirtyCellsLoop(GameState* state);
@@ -0,0 +1,159 @@
+#include "overlay-drawer.hpp"
+
+#include <emscripten/val.h>
+
+#include <string>
+
+#include "../helpers/assert.hpp"
+#include "../helpers/canvas.hpp"
+#include "cube-drawer/cube-drawer.hpp"
+
+// sizes are given for 512px side and scaled with cube size on screen, so
+// overlay covers the same part of the front side at any window size
+const double OVERLAY_BASE_SIDE_SIZE = 512;
+const double OVERLAY_BASE_WIDTH = 400;
+const double OVERLAY_BASE_HEIGHT = 200;
+
+auto getOverlayTitle(EGameStatus status) -> const char* {
+  switch (status) {
+    case EGameStatus::Paused:
+      return "PAUSED";
+    case EGameStatus::Win:
+      return "WIN";
+    case EGameStatus::Fail:
+      return "FAIL";
+    case EGameStatus::Welcome:
+    case EGameStatus::InGame:
+      return "SNAKE 3D";
+  }
+
+  return "SNAKE 3D";
+}
+
+auto createOverlayCanvas() -> emscripten::val {
+  auto document = emscripten::val::global("document");
+  auto canvas =
+      document.call<emscripten::val, std::string>("createElement", "canvas");
+
+  // centered over scene canvas, as cube is, and lets input through to it
+  auto style = canvas["style"];
+  style.set("position", "fixed");
+  style.set("left", "50%");
+  style.set("top", "50%");
+  style.set("transform", "translate(-50%, -50%)");
+  style.set("pointerEvents", "none");
+  style.set("display", "none");
+
+  document["body"].call<void>("appendChild", canvas);
+
+  return canvas;
+}
+
+void renderOverlay(GameState* state, EGameStatus status) {
+  auto& overlay = state->scene.overlay;
+  auto& canvas = overlay.canvases.at(static_cast<int>(status));
+
+  if (!canvas.has_value()) {
+    canvas = createOverlayCanvas();
+  }
+
+  const auto side_size = getProjectedCubeSideSize(overlay.css_size.height);
+  const auto css_scale = side_size / OVERLAY_BASE_SIDE_SIZE;
+
+  // resizing canvas also resets its content and context state
+  resizeCanvas(canvas.value(),
+               {.width = OVERLAY_BASE_WIDTH * css_scale,
+                .height = OVERLAY_BASE_HEIGHT * css_scale},
+               overlay.pixel_ratio);
+
+  auto ctx = canvas->call<emscripten::val, std::string>("getContext", "2d");
+
+  const auto width = canvas.value()["width"].as<double>();
+  const auto height = canvas.value()["height"].as<double>();
+  const auto scale = width / OVERLAY_BASE_WIDTH;
+  const auto padding = 30 * scale;
+  const auto line_width = 3 * scale;
+
+  ctx.set("globalAlpha", 0.7);
+  ctx.set("fillStyle", "white");
+  ctx.call<void>("fillRect", 0, 0, width, height);
+
+  // border is centered on its path, so it is inset to stay inside canvas
+  ctx.set("lineWidth", line_width);
+  ctx.set("strokeStyle", "black");
+  ctx.call<void>("strokeRect", line_width / 2, line_width / 2,
+                 width - line_width, height - line_width);
+
+  // title
+  ctx.set("fillStyle", "black");
+  const auto title_font = getCanvasFontString(static_cast<uint32_t>(70 * scale),
+                                              "Consolas", "px", "bold");
+  ctx.set("font", title_font.data());
+  const auto* title = getOverlayTitle(status);
+
+  const auto title_size = measureCanvasText(ctx, title);
+  ctx.call<void>("fillText", title, width / 2 - title_size.width / 2,
+                 height / 2 + title_size.height / 2);
+
+  // controls hint
+  const auto hint_font =
+      getCanvasFontString(static_cast<uint32_t>(20 * scale), "Consolas");
+  ctx.set("font", hint_font.data());
+  static const char* controls_hint = "WSAD/arrows to control";
+  const auto controls_hint_size = measureCanvasText(ctx, controls_hint);
+  ctx.call<void>("fillText", controls_hint,
+                 width / 2 - controls_hint_size.width / 2,
+                 padding + controls_hint_size.height);
+
+  // start hint
+  static const char* start_hint = "space/enter to start";
+  const auto start_hint_size = measureCanvasText(ctx, start_hint);
+  ctx.call<void>("fillText", start_hint, width / 2 - start_hint_size.width / 2,
+                 height - padding);
+
+  overlay.is_rendered.at(static_cast<int>(status)) = true;
+}
+
+void resizeOverlay(GameState* state) {
+  auto& overlay = state->scene.overlay;
+  overlay.css_size = state->scene.css_size;
+  overlay.pixel_ratio = state->scene.pixel_ratio;
+
+  // overlays of other statuses are rendered again when shown next time
+  overlay.is_rendered.fill(false);
+
+  if (overlay.shown_status.has_value()) {
+    renderOverlay(state, overlay.shown_status.value());
+  }
+}
+
+void drawOverlayLoop(GameState* state) {
+  auto& overlay = state->scene.overlay;
+  const auto status = state->status;
+
+  const auto is_shown = status != EGameStatus::InGame;
+  if (overlay.shown_status == status ||
+      (!is_shown && !overlay.shown_status.has_value())) {
+    return;
+  }
+
+  if (overlay.shown_status.has_value()) {
+    auto& shown_canvas =
+        overlay.canvases.at(static_cast<int>(overlay.shown_status.value()));
+    ASSERT(shown_canvas.has_value());
+    shown_canvas.value()["style"].set("display", "none");
+    overlay.shown_status.reset();
+  }
+
+  if (!is_shown) {
+    return;
+  }
+
+  if (!overlay.is_rendered.at(static_cast<int>(status))) {
+    renderOverlay(state, status);
+  }
+
+  overlay.canvases.at(static_cast<int>(status)).value()["style"].set(
+      "display", "block");
+  overlay.shown_status = status;
+}
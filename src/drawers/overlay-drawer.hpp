@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../models/GameState.hpp"
+
+// to be called after scene size or pixel ratio has changed
+void resizeOverlay(GameState* state);
+
+// shows overlay of current status, rendering it first if needed
+void drawOverlayLoop(GameState* state);
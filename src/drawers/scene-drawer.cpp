@@ -1,22 +1,72 @@
 #include "scene-drawer.hpp"
 
+#include "../helpers/allocations.hpp"
+#include "../helpers/assert.hpp"
+#include "../helpers/canvas.hpp"
+#include "../helpers/frame-governor.hpp"
+#include "../models/QualityTier.hpp"
 #include "cube-drawer/cube-drawer.hpp"
 #include "cube-side-drawer.hpp"
+#include "overlay-drawer.hpp"
 
-void initSceneDrawer(GameState* state, emscripten::val canvas) {
+// sizes canvas backing store for window size and quality tier
+void applyRenderSize(GameState* state) {
+  auto& scene = state->scene;
+  ASSERT(scene.canvas.has_value());
+
+  const auto& tier = QUALITY_TIERS.at(scene.frame_governor.tier);
+  resizeCanvas(scene.canvas.value(), scene.css_size,
+               scene.pixel_ratio * tier.render_scale);
+
+  // resizing canvas clears it
+  scene.cube.needs_redraw = true;
+}
+
+void initSceneDrawer(GameState* state, emscripten::val canvas, Size css_size,
+                     double pixel_ratio) {
   state->scene.canvas = canvas;
+  state->scene.css_size = css_size;
+  state->scene.pixel_ratio = pixel_ratio;
 
-  for (auto& [side_type, side] : state->scene.cube.sides) {
-    initCubeSideDrawer(state, side_type);
-  }
+  applyRenderSize(state);
+  resizeOverlay(state);
 
   initCubeDrawer(state);
 }
 
-void drawSceneLoop(GameState* state) {
-  for (auto& [side_type, side] : state->scene.cube.sides) {
-    drawCubeSideLoop(state, side_type);
+void resizeScene(GameState* state, Size css_size, double pixel_ratio) {
+  state->scene.css_size = css_size;
+  state->scene.pixel_ratio = pixel_ratio;
+
+  applyRenderSize(state);
+  resizeOverlay(state);
+}
+
+auto drawSceneLoop(GameState* state) -> bool {
+  auto& allocations = state->stats.allocations.last_frame;
+
+  const auto phase_start = getAllocationCount();
+
+  collectDirtyCellsLoop(state);
+  const auto is_drawn = drawCubeLoop(state);
+
+  allocations.cube_drawing = getAllocationCountSince(phase_start);
+
+  drawOverlayLoop(state);
+
+  return is_drawn;
+}
+
+void governQualityLoop(GameState* state, double frame_time, double frame_work,
+                       bool is_drawn) {
+  auto& scene = state->scene;
+  const auto tier = addFrameSample(&scene.frame_governor, frame_time,
+                                   frame_work, is_drawn);
+
+  if (!tier.has_value()) {
+    return;
   }
 
-  drawCubeLoop(state);
+  // multisampled framebuffer follows tier on next draw
+  applyRenderSize(state);
 }
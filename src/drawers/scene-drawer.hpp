@@ -3,6 +3,19 @@
 #include <emscripten/val.h>
 
 #include "../models/GameState.hpp"
+#include "../models/Size.hpp"
 
-void initSceneDrawer(GameState* state, emscripten::val canvas);
-void drawSceneLoop(GameState* state);
+void initSceneDrawer(GameState* state, emscripten::val canvas, Size css_size,
+                     double pixel_ratio);
+
+// to be called after window size has changed
+void resizeScene(GameState* state, Size css_size, double pixel_ratio);
+
+// returns whether anything was redrawn
+auto drawSceneLoop(GameState* state) -> bool;
+
+// to be called at the end of each frame, with time main thread spent on it
+// (ms). switches quality tier when frames do not fit budget, or have enough
+// headroom for better one
+void governQualityLoop(GameState* state, double frame_time, double frame_work,
+                       bool is_drawn);
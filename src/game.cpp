@@ -1,37 +1,103 @@
 #include "game.hpp"
 
+#include <emscripten.h>
+
 #include <optional>
 
 #include "actions/control-actions.hpp"
 #include "actions/game-actions.hpp"
+#include "api.hpp"
 #include "drawers/scene-drawer.hpp"
-#include "helpers/canvas.hpp"
+#include "helpers/allocations.hpp"
+#include "helpers/input-trace.hpp"
 #include "models/Size.hpp"
 
+auto getWindowSize() -> Size {
+  auto body = emscripten::val::global("document")["body"];
+
+  return {.width = body["clientWidth"].as<double>(),
+          .height = body["clientHeight"].as<double>()};
+}
+
 Game::Game() {
+  // time origin is page navigation start, so this is how long it took to get
+  // wasm module running
+  state.stats.startup.wasm_instantiate = emscripten_get_now();
+
   auto document = emscripten::val::global("document");
   auto canvas =
       document.call<emscripten::val, std::string>("querySelector", "canvas");
 
   initGameState(&state);
-  initSceneDrawer(&state, canvas);
+  initSceneDrawer(&state, canvas, getWindowSize(),
+                  emscripten::val::global("devicePixelRatio").as<double>());
+  initApi(&state);
 
-  on_resize(0, nullptr, nullptr);
   subscribe();
 
+  last_frame_end_allocations = getAllocationCount();
+
   // start game loop
   emscripten_request_animation_frame_loop(&Game::loop, this);
 }
 
-auto Game::loop([[maybe_unused]] double time, void* data) -> EM_BOOL {
+auto Game::loop(double time, void* data) -> EM_BOOL {
   auto& game = *static_cast<Game*>(data);
+  auto& stats = game.state.stats;
+
+  const auto frame_start = emscripten_get_now();
 
+  // whatever was drawn in previous frame is on screen by now
+  traceFramePresented(&stats, time);
+  stats.frames_count += 1;
+
+  // events only record input, so it is applied once per frame however many
+  // of them came
+  game.applyFrameInput();
+
+  // whatever was allocated since previous frame came from event handlers and
+  // applying their input
+  auto& allocations = stats.allocations.last_frame;
+  allocations.input = getAllocationCountSince(game.last_frame_end_allocations);
+
+  const auto update_start = getAllocationCount();
   updateGameStateLoop(&game.state);
-  drawSceneLoop(&game.state);
+  allocations.update = getAllocationCountSince(update_start);
+
+  const auto is_drawn = drawSceneLoop(&game.state);
+
+  if (allocations.input.count > 0 || allocations.update.count > 0 ||
+      allocations.cube_drawing.count > 0) {
+    stats.allocations.frames_with_allocations += 1;
+  }
+
+  if (stats.frames_count == 1) {
+    const auto now = emscripten_get_now();
+    stats.startup.first_frame = now - time;
+    stats.startup.total = now;
+    reportStartupTimings(&game.state);
+  }
+
+  governQualityLoop(&game.state, time, emscripten_get_now() - frame_start,
+                    is_drawn);
+
+  game.last_frame_end_allocations = getAllocationCount();
 
   return EM_TRUE;
 };
 
+void Game::applyFrameInput() {
+  auto& input = state.input;
+
+  if (input.is_resized) {
+    input.is_resized = false;
+    resizeScene(&state, getWindowSize(),
+                emscripten::val::global("devicePixelRatio").as<double>());
+  }
+
+  applyMouseMoveLoop(&state);
+}
+
 void Game::subscribe() {
   const auto* window =
       EMSCRIPTEN_EVENT_TARGET_WINDOW;  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
@@ -45,18 +111,8 @@ void Game::subscribe() {
 
 auto Game::on_resize([[maybe_unused]] int event_type,
                      [[maybe_unused]] const EmscriptenUiEvent* event,
-                     [[maybe_unused]] void* data) -> EM_BOOL {
-  auto document = emscripten::val::global("document");
-  auto body = document["body"];
-  auto canvas =
-      document.call<emscripten::val, std::string>("querySelector", "canvas");
-
-  const Size window_size{.width = body["clientWidth"].as<double>(),
-                         .height = body["clientHeight"].as<double>()};
-
-  resizeCanvas(canvas, window_size,
-               emscripten::val::global("devicePixelRatio").as<double>());
-
+                     void* data) -> EM_BOOL {
+  static_cast<GameState*>(data)->input.is_resized = true;
   return EM_FALSE;
 }
 
@@ -64,7 +120,8 @@ auto Game::on_keydown([[maybe_unused]] int event_type,
                       [[maybe_unused]] const EmscriptenKeyboardEvent* event,
                       void* data) -> EM_BOOL {
   auto* state = static_cast<GameState*>(data);
-  onKeyDown(state, std::string{event->code});  // NOLINT(hicpp-no-array-decay)
+  // NOLINTNEXTLINE(hicpp-no-array-decay)
+  onKeyDown(state, event->code, event->timestamp);
   return EM_FALSE;
 }
 
@@ -2,6 +2,7 @@
 
 #include <emscripten/html5.h>
 
+#include "models/AllocationStats.hpp"
 #include "models/GameState.hpp"
 
 class Game {
@@ -11,9 +12,13 @@ class Game {
  private:
   GameState state;
 
+  // allocations count when previous frame ended, to tell input allocations
+  AllocationCount last_frame_end_allocations;
+
   static auto loop(double time, void* data) -> EM_BOOL;
 
   void subscribe();
+  void applyFrameInput();
 
   static auto on_resize(int, const EmscriptenUiEvent*, void*) -> EM_BOOL;
   static auto on_keydown(int, const EmscriptenKeyboardEvent*, void*) -> EM_BOOL;
@@ -0,0 +1,33 @@
+#include "allocations.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// program is single-threaded, so no need for atomics
+static AllocationCount allocation_count;  // NOLINT
+
+auto getAllocationCount() -> AllocationCount { return allocation_count; }
+
+auto getAllocationCountSince(const AllocationCount& start) -> AllocationCount {
+  return {.count = allocation_count.count - start.count,
+          .bytes = allocation_count.bytes - start.bytes};
+}
+
+// replacing only basic forms is enough, since default array, nothrow and sized
+// forms forward to them
+auto operator new(std::size_t size) -> void* {
+  allocation_count.count += 1;
+  allocation_count.bytes += static_cast<int64_t>(size);
+
+  // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+  auto* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "../models/AllocationStats.hpp"
+
+// global operator new is replaced to count all heap allocations made by the
+// program (including standard library), so hot paths can be checked to not
+// allocate at all
+
+// allocations made since program start
+auto getAllocationCount() -> AllocationCount;
+
+// allocations made since "start" count was taken
+auto getAllocationCountSince(const AllocationCount& start) -> AllocationCount;
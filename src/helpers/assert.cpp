@@ -1,14 +1,16 @@
 #include "assert.hpp"
 
-void assert(bool condition, const std::string& error_message) {
-  if (!condition) {
-    emscripten_throw_string(error_message.c_str());
-  }
-}
+#include <array>
+#include <cstdio>
+
+#include "../platform/platform.hpp"
+
+void failAssertion(const char* message, const char* file, int line) {
+  static const int ERROR_MESSAGE_MAX_LENGTH = 512;
+  std::array<char, ERROR_MESSAGE_MAX_LENGTH> error_message{};
+
+  std::snprintf(error_message.data(), error_message.size(), "%s, %s:%d",
+                message, file, line);
 
-void assertNotEmpty(const emscripten::val& v,
-                    const std::string& error_message) {
-  if (v.isNull() || v.isUndefined()) {
-    emscripten_throw_string(error_message.c_str());
-  }
+  throwPlatformError(error_message.data());
 }
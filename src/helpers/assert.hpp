@@ -1,26 +1,23 @@
 #pragma once
 
-#include <emscripten.h>
-#include <emscripten/val.h>
-
-#include <sstream>
-#include <string>
+// error message is only formatted when assertion fails, so passing assertions
+// cost a single comparison and do not allocate
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage) no constexpr alternative
-#define ASSERT(condition)                                                    \
-  {                                                                          \
-    std::ostringstream assert_os;                                            \
-    assert_os << #condition << " is false, " << __FILE__ << ":" << __LINE__; \
-    assert(condition, assert_os.str());                                      \
+#define ASSERT(condition)                                        \
+  {                                                              \
+    if (!(condition)) {                                          \
+      failAssertion(#condition " is false", __FILE__, __LINE__); \
+    }                                                            \
   }
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define ASSERT_NOT_EMPTY(condition)                                          \
-  {                                                                          \
-    std::ostringstream assert_os;                                            \
-    assert_os << #condition << " is empty, " << __FILE__ << ":" << __LINE__; \
-    assertNotEmpty(condition, assert_os.str());                              \
+#define ASSERT_NOT_EMPTY(condition)                              \
+  {                                                              \
+    if ((condition).isNull() || (condition).isUndefined()) {     \
+      failAssertion(#condition " is empty", __FILE__, __LINE__); \
+    }                                                            \
   }
 
-void assert(bool condition, const std::string& error_message);
-void assertNotEmpty(const emscripten::val& v, const std::string& error_message);
\ No newline at end of file
+[[noreturn]] void failAssertion(const char* message, const char* file,
+                                int line);
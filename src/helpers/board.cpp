@@ -0,0 +1,161 @@
+#include "board.hpp"
+
+#include <numeric>
+
+#include "assert.hpp"
+
+void resetBoard(Board* board, int cells_count) {
+  board->cells.assign(cells_count, ECellContent::Empty);
+
+  board->free_cells.resize(cells_count);
+  std::iota(board->free_cells.begin(), board->free_cells.end(), 0);
+
+  board->free_cells_positions.resize(cells_count);
+  std::iota(board->free_cells_positions.begin(),
+            board->free_cells_positions.end(), 0);
+
+  board->cells_entities.assign(cells_count, -1);
+
+  board->apples_count = 0;
+  board->stones_count = 0;
+  board->generation += 1;
+}
+
+void resetBoard(Board* board, std::span<const uint8_t> terrain) {
+  const auto cells_count = static_cast<int>(terrain.size());
+
+  board->cells.resize(cells_count);
+  board->cells_entities.assign(cells_count, -1);
+  board->free_cells_positions.resize(cells_count);
+
+  // free cells list never grows past cells count, so it is never reallocated
+  // while round goes
+  board->free_cells.clear();
+  board->free_cells.reserve(cells_count);
+
+  board->apples_count = 0;
+  board->stones_count = 0;
+  board->generation += 1;
+
+  auto& free_cells = board->free_cells;
+  auto& positions = board->free_cells_positions;
+
+  for (int i = 0; i < cells_count; ++i) {
+    const auto cell = static_cast<ECellContent>(terrain[i]);
+    board->cells[i] = cell;
+
+    if (cell == ECellContent::Empty) {
+      positions[i] = static_cast<int>(free_cells.size());
+      free_cells.push_back(i);
+    } else {
+      positions[i] = -1;
+      board->stones_count += cell == ECellContent::Stone ? 1 : 0;
+    }
+  }
+}
+
+auto getContentCounter(Board* board, ECellContent content) -> int* {
+  switch (content) {
+    case ECellContent::Apple:
+      return &board->apples_count;
+    case ECellContent::Stone:
+      return &board->stones_count;
+    case ECellContent::Empty:
+    case ECellContent::Snake:
+    case ECellContent::SlowDown:
+      return nullptr;
+  }
+
+  return nullptr;
+}
+
+void setBoardCell(Board* board, int cell_idx, ECellContent content) {
+  auto& cell = board->cells.at(cell_idx);
+  if (cell == content) {
+    return;
+  }
+
+  if (auto* counter = getContentCounter(board, cell)) {
+    *counter -= 1;
+  }
+  if (auto* counter = getContentCounter(board, content)) {
+    *counter += 1;
+  }
+
+  auto& free_cells = board->free_cells;
+  auto& positions = board->free_cells_positions;
+
+  if (!board->changes.empty()) {
+    const auto changes_size = static_cast<int64_t>(board->changes.size());
+    board->changes[board->changes_count % changes_size] =
+        BoardChange{.cell_idx = cell_idx,
+                    .content = cell,
+                    .free_cells_position = positions[cell_idx]};
+  }
+  board->changes_count += 1;
+
+  if (content == ECellContent::Empty) {
+    // cell gets free
+    positions[cell_idx] = static_cast<int>(free_cells.size());
+    free_cells.push_back(cell_idx);
+  } else if (cell == ECellContent::Empty) {
+    // cell gets taken. move last free cell in its place, so list stays dense
+    const auto position = positions[cell_idx];
+    ASSERT(position >= 0);
+
+    const auto last_free_cell = free_cells.back();
+    free_cells[position] = last_free_cell;
+    positions[last_free_cell] = position;
+
+    free_cells.pop_back();
+    positions[cell_idx] = -1;
+  }
+
+  cell = content;
+}
+
+void undoBoardChange(Board* board, const BoardChange& change) {
+  auto& cell = board->cells.at(change.cell_idx);
+
+  if (auto* counter = getContentCounter(board, cell)) {
+    *counter -= 1;
+  }
+  if (auto* counter = getContentCounter(board, change.content)) {
+    *counter += 1;
+  }
+
+  auto& free_cells = board->free_cells;
+  auto& positions = board->free_cells_positions;
+
+  if (cell == ECellContent::Empty) {
+    // cell was freed, so it is the last free cell
+    ASSERT(free_cells.back() == change.cell_idx);
+    free_cells.pop_back();
+    positions[change.cell_idx] = -1;
+  } else if (change.content == ECellContent::Empty) {
+    // cell was taken, and last free cell was moved in its place. move it back
+    const auto position = change.free_cells_position;
+    if (position < static_cast<int>(free_cells.size())) {
+      const auto moved_cell = free_cells[position];
+      positions[moved_cell] = static_cast<int>(free_cells.size());
+      free_cells.push_back(moved_cell);
+      free_cells[position] = change.cell_idx;
+    } else {
+      free_cells.push_back(change.cell_idx);
+    }
+    positions[change.cell_idx] = position;
+  }
+
+  cell = change.content;
+  board->generation += 1;
+}
+
+auto getRandomFreeCell(Board* board) -> std::optional<int> {
+  const auto& free_cells = board->free_cells;
+  if (free_cells.empty()) {
+    return std::nullopt;
+  }
+
+  std::uniform_int_distribution<std::size_t> dist(0, free_cells.size() - 1);
+  return free_cells[dist(board->random_engine)];
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "../models/Board.hpp"
+#include "../models/ECellContent.hpp"
+
+// makes all cells empty. keeps memory when cells count stays the same
+void resetBoard(Board* board, int cells_count);
+
+// same, but with terrain (empty cells and stones) set from ECellContent values
+void resetBoard(Board* board, std::span<const uint8_t> terrain);
+
+void setBoardCell(Board* board, int cell_idx, ECellContent content);
+
+// reverts change from journal. changes are to be undone latest first, so free
+// cells list gets exactly the same order it had
+void undoBoardChange(Board* board, const BoardChange& change);
+
+// random empty cell, or nothing when board is full
+auto getRandomFreeCell(Board* board) -> std::optional<int>;
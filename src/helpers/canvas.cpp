@@ -1,34 +1,56 @@
 #include "canvas.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <array>
 #include <cmath>
-#include <sstream>
+#include <cstdio>
+#include <iterator>
 
-auto getCanvasFontString(uint32_t size, const std::string& family,
-                         const std::string& unit, const std::string& weight)
-    -> std::string {
-  std::ostringstream os;
+auto getCanvasFontString(uint32_t size, std::string_view family,
+                         std::string_view unit, std::string_view weight)
+    -> CanvasFontString {
+  CanvasFontString res{};
+
+  // leave space for null terminator
+  auto* it = res.begin();
+  auto* const end = std::prev(res.end());
+
+  const auto append = [&it, end](std::string_view str) {
+    const auto count =
+        std::min(str.size(), static_cast<std::size_t>(end - it));
+    it = std::copy_n(str.begin(), count, it);
+  };
 
   if (!weight.empty()) {
-    os << weight << ' ';
+    append(weight);
+    append(" ");
   }
 
-  os << size << unit << ' ' << family;
+  it = std::to_chars(it, end, size).ptr;
+
+  append(unit);
+  append(" ");
+  append(family);
 
-  return os.str();
+  return res;
 }
 
 void resizeCanvas(emscripten::val canvas, Size css_size, double pixel_ratio) {
   canvas.set("width", css_size.width * pixel_ratio);
   canvas.set("height", css_size.height * pixel_ratio);
 
-  canvas["style"].set("width", std::to_string(css_size.width) + "px");
-  canvas["style"].set("height", std::to_string(css_size.height) + "px");
+  // format in place, so resize does not touch the heap
+  std::array<char, 32> css_value{};
+  std::snprintf(css_value.data(), css_value.size(), "%gpx", css_size.width);
+  canvas["style"].set("width", css_value.data());
+  std::snprintf(css_value.data(), css_value.size(), "%gpx", css_size.height);
+  canvas["style"].set("height", css_value.data());
 }
 
-auto measureCanvasText(const emscripten::val& canvas_ctx_2d,
-                       const std::string& text) -> Size {
-  auto text_size = canvas_ctx_2d.call<emscripten::val, const std::string&>(
-      "measureText", text);
+auto measureCanvasText(const emscripten::val& canvas_ctx_2d, const char* text)
+    -> Size {
+  auto text_size = canvas_ctx_2d.call<emscripten::val>("measureText", text);
 
   return {
       .width = std::ceil(text_size["width"].as<double>()),
@@ -2,15 +2,21 @@
 
 #include <emscripten/val.h>
 
-#include <string>
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 #include "../models/Size.hpp"
 
-auto getCanvasFontString(uint32_t size = 8, const std::string& family = "Arial",
-                         const std::string& unit = "px",
-                         const std::string& weight = "") -> std::string;
+// null-terminated font string in fixed-size buffer, so it can be built without
+// heap allocations or stream formatting
+using CanvasFontString = std::array<char, 64>;
+
+auto getCanvasFontString(uint32_t size = 8, std::string_view family = "Arial",
+                         std::string_view unit = "px",
+                         std::string_view weight = "") -> CanvasFontString;
 
 void resizeCanvas(emscripten::val canvas, Size css_size, double pixel_ratio);
 
-auto measureCanvasText(const emscripten::val& canvas_ctx_2d,
-                       const std::string& text) -> Size;
+auto measureCanvasText(const emscripten::val& canvas_ctx_2d, const char* text)
+    -> Size;
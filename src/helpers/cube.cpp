@@ -1,14 +1,14 @@
 #include "cube.hpp"
 
-#include <emscripten/emscripten.h>
-
 #include <cmath>
-#include <random>
 
 #include "../drawers/cube-drawer/geometry/cube-side-coords-range.hpp"
+#include "../platform/platform.hpp"
 #include "graphics-math.hpp"
 #include "ranges.hpp"
 
+const int CUBE_SIDES_COUNT = 6;
+
 auto getPosition3dForCubePosition(const CubePosition& pos, const Grid& grid)
     -> Point3D {
   auto vert_ratio = (pos.row + 0.5) / grid.rows_count;
@@ -43,7 +43,7 @@ auto getPosition3dForCubePosition(const CubePosition& pos, const Grid& grid)
           .z = ranges.z[0] + dz * vert_ratio,
       };
     default:
-      emscripten_throw_string("Unknown cube side");
+      throwPlatformError("Unknown cube side");
   }
 }
 
@@ -70,6 +70,27 @@ auto getCubeRotationForPosition(const CubePosition& pos, const Grid& grid)
   };
 }
 
+auto getCellsCount(const Grid& grid) -> int {
+  return CUBE_SIDES_COUNT * grid.rows_count * grid.cols_count;
+}
+
+// cells are indexed side by side, row by row
+auto getCellIndex(const CubePosition& pos, const Grid& grid) -> int {
+  return (static_cast<int>(pos.side) * grid.rows_count + pos.row) *
+             grid.cols_count +
+         pos.col;
+}
+
+auto getCubePositionForCellIndex(int cell_idx, const Grid& grid)
+    -> CubePosition {
+  const auto side_cells_count = grid.rows_count * grid.cols_count;
+  const auto side_cell_idx = cell_idx % side_cells_count;
+
+  return {.side = static_cast<ECubeSide>(cell_idx / side_cells_count),
+          .row = side_cell_idx / grid.cols_count,
+          .col = side_cell_idx % grid.cols_count};
+}
+
 auto getNextCubePositionAndDirection(const CubePosition& pos,
                                      EDirection direction, const Grid& grid)
     -> std::pair<CubePosition, EDirection> {
@@ -240,20 +261,3 @@ auto getNextCubePositionAndDirection(const CubePosition& pos,
 
   return {next_pos, next_direction};
 }
-
-auto getRandomCubePosition(const Cube& cube) -> CubePosition {
-  std::random_device device;
-  std::mt19937 engine(device());
-
-  std::uniform_int_distribution<std::mt19937::result_type> side_dist(
-      0, cube.sides.size() - 1);
-
-  std::uniform_int_distribution<int> row_dist(0, cube.grid.rows_count - 1);
-  std::uniform_int_distribution<int> col_dist(0, cube.grid.cols_count - 1);
-
-  return {
-      .side = static_cast<ECubeSide>(side_dist(engine)),
-      .row = row_dist(engine),
-      .col = col_dist(engine),
-  };
-}
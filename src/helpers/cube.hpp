@@ -16,8 +16,11 @@ auto getPosition3dForCubePosition(const CubePosition& pos, const Grid& grid)
 auto getCubeRotationForPosition(const CubePosition& pos, const Grid& grid)
     -> ModelRotation;
 
+auto getCellsCount(const Grid& grid) -> int;
+auto getCellIndex(const CubePosition& pos, const Grid& grid) -> int;
+auto getCubePositionForCellIndex(int cell_idx, const Grid& grid)
+    -> CubePosition;
+
 auto getNextCubePositionAndDirection(const CubePosition& pos,
                                      EDirection direction, const Grid& grid)
-    -> std::pair<CubePosition, EDirection>;
-
-auto getRandomCubePosition(const Cube& cube) -> CubePosition;
\ No newline at end of file
+    -> std::pair<CubePosition, EDirection>;
\ No newline at end of file
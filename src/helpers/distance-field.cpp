@@ -0,0 +1,206 @@
+#include "distance-field.hpp"
+
+#include <algorithm>
+
+#include "cube.hpp"
+#include "direction.hpp"
+
+void buildCubeGraph(CubeGraph* graph, const Grid& grid) {
+  const auto cells_count = getCellsCount(grid);
+
+  graph->grid = grid;
+  graph->neighbours.resize(cells_count);
+  graph->back_directions.resize(cells_count);
+
+  for (int cell_idx = 0; cell_idx < cells_count; ++cell_idx) {
+    const auto pos = getCubePositionForCellIndex(cell_idx, grid);
+
+    for (int i = 0; i < 4; ++i) {
+      const auto direction = static_cast<EDirection>(i);
+      const auto [next_pos, next_direction] =
+          getNextCubePositionAndDirection(pos, direction, grid);
+
+      graph->neighbours[cell_idx][i] = getCellIndex(next_pos, grid);
+
+      // direction turns when crossing cube edge, so the way back is opposite
+      // to the direction snake would have on the neighbour cell
+      graph->back_directions[cell_idx][i] =
+          getOppositeDirection(next_direction);
+    }
+  }
+}
+
+// grows distances from queued cells and seeds, in order of their distances.
+// queued cells are in that order already, seeds are to be sorted. only cells
+// which get closer are searched further
+void expandDistanceField(DistanceField* field, const CubeGraph& graph) {
+  auto& distances = field->distances;
+  auto& queue = field->queue;
+  const auto& seeds = field->seeds;
+
+  std::size_t queue_pos = 0;
+  std::size_t seeds_pos = 0;
+
+  while (queue_pos < queue.size() || seeds_pos < seeds.size()) {
+    // queue distances never decrease, so merging it with sorted seeds keeps
+    // cells in breadth-first order
+    const auto take_seed =
+        seeds_pos < seeds.size() &&
+        (queue_pos == queue.size() ||
+         distances[seeds[seeds_pos]] <= distances[queue[queue_pos]]);
+    const auto cell_idx = take_seed ? seeds[seeds_pos++] : queue[queue_pos++];
+
+    const auto distance = distances[cell_idx] + 1;
+    for (int i = 0; i < 4; ++i) {
+      const auto next_idx = graph.neighbours[cell_idx][i];
+      auto& next_distance = distances[next_idx];
+
+      if (next_distance != DistanceField::BLOCKED &&
+          distance < next_distance) {
+        next_distance = distance;
+        field->directions[next_idx] = graph.back_directions[cell_idx][i];
+        queue.push_back(next_idx);
+      }
+    }
+  }
+
+  queue.clear();
+  field->seeds.clear();
+}
+
+// cells which reach the nearest source through given cell lose their
+// distances, and get them again from cells around them
+void invalidateDistanceField(DistanceField* field, const CubeGraph& graph,
+                             int cell_idx, int distance) {
+  auto& distances = field->distances;
+  auto& queue = field->queue;
+  auto& seeds = field->seeds;
+
+  queue.push_back(cell_idx);
+
+  // collect cells whose first step leads to a collected cell
+  for (std::size_t i = 0; i < queue.size(); ++i) {
+    const auto idx = queue[i];
+    const auto idx_distance = distances[idx];
+    if (idx_distance == DistanceField::UNREACHABLE) {
+      continue;
+    }
+
+    for (int j = 0; j < 4; ++j) {
+      const auto next_idx = graph.neighbours[idx][j];
+      const auto next_direction = static_cast<int>(field->directions[next_idx]);
+
+      if (distances[next_idx] == idx_distance + 1 &&
+          graph.neighbours[next_idx][next_direction] == idx) {
+        queue.push_back(next_idx);
+      }
+    }
+  }
+
+  for (const auto idx : queue) {
+    distances[idx] = DistanceField::UNREACHABLE;
+  }
+  distances[cell_idx] = distance;
+
+  for (const auto idx : queue) {
+    for (const auto next_idx : graph.neighbours[idx]) {
+      const auto next_distance = distances[next_idx];
+      if (next_distance != DistanceField::BLOCKED &&
+          next_distance != DistanceField::UNREACHABLE) {
+        seeds.push_back(next_idx);
+      }
+    }
+  }
+
+  queue.clear();
+
+  std::sort(seeds.begin(), seeds.end(), [&distances](int lhs, int rhs) {
+    return distances[lhs] < distances[rhs];
+  });
+
+  expandDistanceField(field, graph);
+}
+
+void addDistanceFieldSource(DistanceField* field, const CubeGraph& graph,
+                            int cell_idx) {
+  field->distances[cell_idx] = 0;
+  field->queue.push_back(cell_idx);
+  expandDistanceField(field, graph);
+}
+
+void updateDistanceFieldCell(DistanceField* field, const CubeGraph& graph,
+                             const Board& board, int cell_idx) {
+  const auto content = board.cells[cell_idx];
+  const auto distance = field->distances[cell_idx];
+
+  const auto is_blocked = content == ECellContent::Stone;
+  const auto is_source = content == field->source_content;
+  const auto was_blocked = distance == DistanceField::BLOCKED;
+  const auto was_source = distance == 0;
+
+  if (is_blocked == was_blocked && is_source == was_source) {
+    return;
+  }
+
+  if (is_source) {
+    addDistanceFieldSource(field, graph, cell_idx);
+  } else if (!was_blocked) {
+    // whatever cell has become, cells behind it find another way
+    invalidateDistanceField(
+        field, graph, cell_idx,
+        is_blocked ? DistanceField::BLOCKED : DistanceField::UNREACHABLE);
+  } else {
+    // cell has opened, and is reached from cells around it
+    field->distances[cell_idx] = DistanceField::UNREACHABLE;
+    invalidateDistanceField(field, graph, cell_idx,
+                            DistanceField::UNREACHABLE);
+  }
+}
+
+void resetDistanceField(DistanceField* field, const CubeGraph& graph,
+                        const Board& board) {
+  const auto cells_count = static_cast<int>(board.cells.size());
+
+  field->distances.assign(cells_count, DistanceField::UNREACHABLE);
+  field->directions.resize(cells_count);
+
+  // each cell is queued once at most, so these do not grow while round goes
+  field->queue.reserve(cells_count);
+  field->seeds.reserve(cells_count * 4);
+
+  for (int i = 0; i < cells_count; ++i) {
+    const auto content = board.cells[i];
+    if (content == ECellContent::Stone) {
+      field->distances[i] = DistanceField::BLOCKED;
+    } else if (content == field->source_content) {
+      field->distances[i] = 0;
+      field->queue.push_back(i);
+    }
+  }
+
+  expandDistanceField(field, graph);
+
+  field->synced_board_generation = board.generation;
+  field->synced_board_changes_count = board.changes_count;
+}
+
+void syncDistanceField(DistanceField* field, const CubeGraph& graph,
+                       const Board& board) {
+  const auto changes_size = static_cast<int64_t>(board.changes.size());
+  const auto changes_start = field->synced_board_changes_count;
+
+  if (field->synced_board_generation != board.generation ||
+      board.changes_count - changes_start > changes_size) {
+    resetDistanceField(field, graph, board);
+    return;
+  }
+
+  // cell may be in journal several times. it is compared with its current
+  // content each time, so repeated cells are skipped
+  for (auto i = changes_start; i < board.changes_count; ++i) {
+    updateDistanceFieldCell(field, graph, board,
+                            board.changes[i % changes_size].cell_idx);
+  }
+
+  field->synced_board_changes_count = board.changes_count;
+}
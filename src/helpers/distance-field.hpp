@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../models/Board.hpp"
+#include "../models/CubeGraph.hpp"
+#include "../models/DistanceField.hpp"
+#include "../models/Grid.hpp"
+
+void buildCubeGraph(CubeGraph* graph, const Grid& grid);
+
+// searches all cells from all sources at once
+void resetDistanceField(DistanceField* field, const CubeGraph& graph,
+                        const Board& board);
+
+// applies board changes made since last sync. starts over when journal does
+// not have them all
+void syncDistanceField(DistanceField* field, const CubeGraph& graph,
+                       const Board& board);
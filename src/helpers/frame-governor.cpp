@@ -0,0 +1,154 @@
+#include "frame-governor.hpp"
+
+#include <algorithm>
+
+#include "../models/QualityTier.hpp"
+
+// budget is never tighter than that, even on high refresh rate displays
+const double MIN_FRAME_BUDGET = 1000.0 / 60;  // ms
+const int WINDOW_FRAMES_COUNT = 60;
+
+// frames are dropped when they come that much slower than budget on average.
+// slow frames alone do not tell tier is too expensive, since rAF may come
+// late while main thread is idle (eg. throttled by browser), so main thread
+// also has to be busy for big share of budget
+const double MISSED_BUDGET_RATIO = 1.2;
+const double MISSED_BUDGET_WORK_RATIO = 0.5;
+
+// gpu time is not visible from main thread, so headroom means both: frames
+// come on time, and main thread is mostly idle
+const double ON_TIME_RATIO = 1.05;
+const double HEADROOM_WORK_RATIO = 0.4;
+
+// longer pauses (eg. when tab was in background) tell nothing about rendering
+const double MAX_FRAME_INTERVAL = 250;  // ms
+
+// first window after tier change may still have frames of previous tier
+const int SETTLE_WINDOWS_COUNT = 1;
+
+// step down that soon after step up means better tier does not fit
+const int FAILED_STEP_UP_WINDOWS_COUNT = 2;
+
+// without MSAA, tiers which differ only in it look and cost the same
+auto isSameTier(const FrameGovernor& governor, int tier_a, int tier_b)
+    -> bool {
+  return tier_a == tier_b ||
+         (!governor.is_msaa_available &&
+          QUALITY_TIERS.at(tier_a).render_scale ==
+              QUALITY_TIERS.at(tier_b).render_scale);
+}
+
+// first cheaper tier which is not the same as current one
+auto getCheaperTier(const FrameGovernor& governor, int tier) -> int {
+  const auto worst_tier = static_cast<int>(QUALITY_TIERS.size()) - 1;
+
+  auto cheaper_tier = tier + 1;
+  while (cheaper_tier < worst_tier &&
+         isSameTier(governor, tier, cheaper_tier)) {
+    cheaper_tier += 1;
+  }
+
+  return cheaper_tier;
+}
+
+// best of the same better tiers, so there is no step up to the same tier
+// afterwards
+auto getBetterTier(const FrameGovernor& governor, int tier) -> int {
+  auto better_tier = tier - 1;
+  while (better_tier > 0 &&
+         isSameTier(governor, better_tier - 1, better_tier)) {
+    better_tier -= 1;
+  }
+
+  return better_tier;
+}
+
+auto changeTier(FrameGovernor* governor, int tier) -> int {
+  governor->last_change_was_step_up = tier < governor->tier;
+  governor->tier = tier;
+  governor->windows_since_change = 0;
+  governor->headroom_windows_count = 0;
+
+  return tier;
+}
+
+auto addFrameSample(FrameGovernor* governor, double frame_time,
+                    double frame_work, bool is_drawn) -> std::optional<int> {
+  const auto last_frame_time = governor->last_frame_time;
+  governor->last_frame_time = frame_time;
+
+  if (!is_drawn || !last_frame_time.has_value()) {
+    return std::nullopt;
+  }
+
+  const auto frame_interval = frame_time - last_frame_time.value();
+  if (frame_interval > MAX_FRAME_INTERVAL) {
+    return std::nullopt;
+  }
+
+  governor->min_frame_interval =
+      governor->frames_count == 0
+          ? frame_interval
+          : std::min(governor->min_frame_interval, frame_interval);
+  governor->frames_count += 1;
+  governor->frame_intervals_sum += frame_interval;
+  governor->frame_work_sum += frame_work;
+
+  if (governor->frames_count < WINDOW_FRAMES_COUNT) {
+    return std::nullopt;
+  }
+
+  governor->avg_frame_interval =
+      governor->frame_intervals_sum / governor->frames_count;
+  governor->avg_frame_work = governor->frame_work_sum / governor->frames_count;
+
+  // rAF never comes sooner than display refreshes, so the shortest interval
+  // is the best frame time which can be had
+  governor->frame_budget =
+      std::max(MIN_FRAME_BUDGET, governor->min_frame_interval);
+  const auto budget = governor->frame_budget;
+
+  governor->frames_count = 0;
+  governor->frame_intervals_sum = 0;
+  governor->frame_work_sum = 0;
+  governor->windows_since_change += 1;
+
+  if (governor->windows_since_change <= SETTLE_WINDOWS_COUNT) {
+    return std::nullopt;
+  }
+
+  const auto tier = governor->tier;
+  const auto worst_tier = static_cast<int>(QUALITY_TIERS.size()) - 1;
+
+  if (governor->avg_frame_interval > budget * MISSED_BUDGET_RATIO &&
+      governor->avg_frame_work > budget * MISSED_BUDGET_WORK_RATIO) {
+    governor->headroom_windows_count = 0;
+
+    if (tier == worst_tier) {
+      return std::nullopt;
+    }
+
+    if (governor->last_change_was_step_up &&
+        governor->windows_since_change <=
+            SETTLE_WINDOWS_COUNT + FAILED_STEP_UP_WINDOWS_COUNT) {
+      governor->headroom_windows_needed =
+          std::min(governor->headroom_windows_needed * 2,
+                   FrameGovernor::MAX_HEADROOM_WINDOWS_NEEDED);
+    }
+
+    return changeTier(governor, getCheaperTier(*governor, tier));
+  }
+
+  const auto has_headroom =
+      governor->avg_frame_interval < budget * ON_TIME_RATIO &&
+      governor->avg_frame_work < budget * HEADROOM_WORK_RATIO;
+  governor->headroom_windows_count =
+      has_headroom ? governor->headroom_windows_count + 1 : 0;
+
+  if (tier > 0 &&
+      governor->headroom_windows_count >= governor->headroom_windows_needed) {
+    return changeTier(governor, getBetterTier(*governor, tier));
+  }
+
+  return std::nullopt;
+}
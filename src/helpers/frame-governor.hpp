@@ -0,0 +1,10 @@
+#pragma once
+
+#include <optional>
+
+#include "../models/FrameGovernor.hpp"
+
+// feeds frame to governor: its rAF time, time main thread spent on it (ms),
+// and whether it drew anything. returns new tier when tier should change
+auto addFrameSample(FrameGovernor* governor, double frame_time,
+                    double frame_work, bool is_drawn) -> std::optional<int>;
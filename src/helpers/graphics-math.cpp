@@ -1,5 +1,7 @@
 #include "graphics-math.hpp"
 
+#include <algorithm>
+
 /**
  * Takes two 4-by-4 matrices, a and b, and computes the product in the order
  * that pre-composes b with a.  In other words, the matrix returned will
@@ -362,3 +364,126 @@ auto getAngleBetweenVectors(const Point3D& a, const Point3D& b) -> Radians {
 
   return std::acos(angle_cos);
 }
+
+/**
+ * Computes the Hamilton product of 2 quaternions. Resulting rotation applies b
+ * first and then a, same as with matrices
+ */
+auto multiply(const Quaternion& a, const Quaternion& b) -> Quaternion {
+  return {
+      .w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+      .x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+      .y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+      .z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+  };
+}
+
+/**
+ * Converts rotation around X and Y axes to quaternion. Produces the same
+ * orientation as yRotate(xRotate(m, x), y)
+ */
+auto getQuaternionForRotation(const ModelRotation& rotation) -> Quaternion {
+  const auto half_x = degToRad(rotation.x) / 2;
+  const auto half_y = degToRad(rotation.y) / 2;
+
+  const Quaternion x_rotation{
+      .w = std::cos(half_x), .x = std::sin(half_x), .y = 0, .z = 0};
+  const Quaternion y_rotation{
+      .w = std::cos(half_y), .x = 0, .y = std::sin(half_y), .z = 0};
+
+  return multiply(x_rotation, y_rotation);
+}
+
+/**
+ * Computes angle of the shortest rotation from one orientation to another
+ */
+auto getAngleBetweenQuaternions(const Quaternion& a, const Quaternion& b)
+    -> Radians {
+  auto dot = std::abs(a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z);
+  return 2 * std::acos(std::min(dot, 1.0));
+}
+
+/**
+ * Spherical linear interpolation between 2 orientations along the shortest arc.
+ * t = 0 gives a, t = 1 gives b
+ */
+auto slerp(const Quaternion& a, const Quaternion& b, double t) -> Quaternion {
+  auto dot = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+
+  // q and -q describe the same orientation. pick the one closer to a, so we
+  // rotate along the shortest arc
+  auto sign = 1.0;
+  if (dot < 0) {
+    dot = -dot;
+    sign = -1.0;
+  }
+
+  auto a_weight = 1 - t;
+  auto b_weight = t;
+
+  // fall back to linear interpolation when orientations are too close, to
+  // avoid division by sine of near-zero angle
+  static const double DELTA = 0.9995;
+  if (dot < DELTA) {
+    const auto angle = std::acos(dot);
+    const auto angle_sin = std::sin(angle);
+    a_weight = std::sin((1 - t) * angle) / angle_sin;
+    b_weight = std::sin(t * angle) / angle_sin;
+  }
+
+  b_weight *= sign;
+
+  Quaternion res{
+      .w = a_weight * a.w + b_weight * b.w,
+      .x = a_weight * a.x + b_weight * b.x,
+      .y = a_weight * a.y + b_weight * b.y,
+      .z = a_weight * a.z + b_weight * b.z,
+  };
+
+  const auto length = std::sqrt(res.w * res.w + res.x * res.x +
+                                res.y * res.y + res.z * res.z);
+  res.w /= length;
+  res.x /= length;
+  res.y /= length;
+  res.z /= length;
+
+  return res;
+}
+
+/**
+ * Multiply by a rotation matrix of unit quaternion
+ * this is the shortcut for
+ * return multiply(m, quaternionToMatrix(q));
+ */
+auto rotate(const Matrix4& m, const Quaternion& q) -> Matrix4 {
+  const auto xx = q.x * q.x;
+  const auto yy = q.y * q.y;
+  const auto zz = q.z * q.z;
+  const auto xy = q.x * q.y;
+  const auto xz = q.x * q.z;
+  const auto yz = q.y * q.z;
+  const auto wx = q.w * q.x;
+  const auto wy = q.w * q.y;
+  const auto wz = q.w * q.z;
+
+  Matrix4 rotation;
+
+  rotation[0] = static_cast<float>(1 - 2 * (yy + zz));
+  rotation[1] = static_cast<float>(2 * (xy + wz));
+  rotation[2] = static_cast<float>(2 * (xz - wy));
+  rotation[3] = 0;
+  rotation[4] = static_cast<float>(2 * (xy - wz));
+  rotation[5] = static_cast<float>(1 - 2 * (xx + zz));
+  rotation[6] = static_cast<float>(2 * (yz + wx));
+  rotation[7] = 0;
+  rotation[8] = static_cast<float>(2 * (xz + wy));
+  rotation[9] = static_cast<float>(2 * (yz - wx));
+  rotation[10] = static_cast<float>(1 - 2 * (xx + yy));
+  rotation[11] = 0;
+  rotation[12] = 0;
+  rotation[13] = 0;
+  rotation[14] = 0;
+  rotation[15] = 1;
+
+  return multiply(m, rotation);
+}
@@ -3,7 +3,9 @@
 #include <array>
 #include <cmath>
 
+#include "../models/ModelRotation.hpp"
 #include "../models/Point3D.hpp"
+#include "../models/Quaternion.hpp"
 #include "../models/angles.hpp"
 
 using Matrix4 = std::array<float, 4 * 4>;
@@ -31,4 +33,11 @@ auto yRotate(Matrix4 m, Radians angle) -> Matrix4;
 auto perspective(Radians field_of_view, float aspect, float near, float far)
     -> Matrix4;
 
-auto getAngleBetweenVectors(const Point3D& a, const Point3D& b) -> Radians;
\ No newline at end of file
+auto getAngleBetweenVectors(const Point3D& a, const Point3D& b) -> Radians;
+
+auto multiply(const Quaternion& a, const Quaternion& b) -> Quaternion;
+auto getQuaternionForRotation(const ModelRotation& rotation) -> Quaternion;
+auto getAngleBetweenQuaternions(const Quaternion& a, const Quaternion& b)
+    -> Radians;
+auto slerp(const Quaternion& a, const Quaternion& b, double t) -> Quaternion;
+auto rotate(const Matrix4& m, const Quaternion& q) -> Matrix4;
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "input-trace.hpp"
+
+#include "../platform/platform.hpp"
+#include "latency.hpp"
+
+void startInputTrace(Stats* stats, double key_time, ECubeSide side) {
+  const auto now = getNow();
+
+  // snake moves at most once per frame, so previous trace should be finished
+  // by now. if it is not (eg. side was not uploaded) just drop it
+  stats->input_trace = InputTrace{.key_time = key_time,
+                                  .move_time = now,
+                                  .texture_upload_time = std::nullopt,
+                                  .side = side};
+
+  addLatencySample(&stats->key_to_move, now - key_time);
+}
+
+void traceTextureUploaded(Stats* stats, ECubeSide side) {
+  auto& trace = stats->input_trace;
+
+  if (trace.has_value() && trace->side == side &&
+      !trace->texture_upload_time.has_value()) {
+    const auto now = getNow();
+    trace->texture_upload_time = now;
+    addLatencySample(&stats->move_to_texture_upload, now - trace->move_time);
+  }
+}
+
+// browser presents drawings made in animation frame callback right after it
+// returns, so start of next animation frame is the closest point to the moment
+// they actually reach the screen we can observe
+void traceFramePresented(Stats* stats, double frame_time) {
+  auto& trace = stats->input_trace;
+
+  if (trace.has_value() && trace->texture_upload_time.has_value()) {
+    addLatencySample(&stats->texture_upload_to_present,
+                     frame_time - trace->texture_upload_time.value());
+    addLatencySample(&stats->key_to_present, frame_time - trace->key_time);
+    trace.reset();
+  }
+}
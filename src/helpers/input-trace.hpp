@@ -0,0 +1,8 @@
+#pragma once
+
+#include "../models/ECubeSide.hpp"
+#include "../models/Stats.hpp"
+
+void startInputTrace(Stats* stats, double key_time, ECubeSide side);
+void traceTextureUploaded(Stats* stats, ECubeSide side);
+void traceFramePresented(Stats* stats, double frame_time);
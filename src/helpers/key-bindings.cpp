@@ -0,0 +1,151 @@
+#include "key-bindings.hpp"
+
+#include <cstdint>
+#include <limits>
+
+// FNV-1a with seed mixed into offset basis, so that different seeds give
+// different hash functions
+constexpr auto hashKeyCode(std::string_view code, uint32_t seed) -> uint32_t {
+  constexpr uint32_t FNV_OFFSET_BASIS = 2166136261U;
+  constexpr uint32_t FNV_PRIME = 16777619U;
+
+  auto hash = FNV_OFFSET_BASIS ^ seed;
+  for (const auto c : code) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= FNV_PRIME;
+  }
+
+  return hash;
+}
+
+// power of two, so slot is taken by masking hash
+constexpr std::size_t KEY_CODES_TABLE_SIZE = 256;
+constexpr uint8_t EMPTY_SLOT = std::numeric_limits<uint8_t>::max();
+
+static_assert(KEY_CODES.size() < EMPTY_SLOT);
+
+constexpr auto getKeyCodeSlot(std::string_view code, uint32_t seed)
+    -> std::size_t {
+  return hashKeyCode(code, seed) & (KEY_CODES_TABLE_SIZE - 1);
+}
+
+constexpr auto isKeyCodesSeedPerfect(uint32_t seed) -> bool {
+  std::array<bool, KEY_CODES_TABLE_SIZE> taken{};
+
+  for (const auto code : KEY_CODES) {
+    const auto slot = getKeyCodeSlot(code, seed);
+    if (taken.at(slot)) {
+      return false;
+    }
+    taken.at(slot) = true;
+  }
+
+  return true;
+}
+
+// first seed which gives no collisions for key codes list
+constexpr auto findKeyCodesSeed() -> std::optional<uint32_t> {
+  constexpr uint32_t MAX_SEED = 10000;
+
+  for (uint32_t seed = 0; seed < MAX_SEED; ++seed) {
+    if (isKeyCodesSeedPerfect(seed)) {
+      return seed;
+    }
+  }
+
+  return std::nullopt;
+}
+
+constexpr auto KEY_CODES_SEED = findKeyCodesSeed();
+static_assert(KEY_CODES_SEED.has_value(),
+              "no perfect hash seed for KEY_CODES, enlarge the table");
+
+// slot to key code index
+constexpr auto buildKeyCodesTable()
+    -> std::array<uint8_t, KEY_CODES_TABLE_SIZE> {
+  std::array<uint8_t, KEY_CODES_TABLE_SIZE> table{};
+  for (auto& slot : table) {
+    slot = EMPTY_SLOT;
+  }
+
+  for (std::size_t i = 0; i < KEY_CODES.size(); ++i) {
+    table.at(getKeyCodeSlot(KEY_CODES.at(i), KEY_CODES_SEED.value())) =
+        static_cast<uint8_t>(i);
+  }
+
+  return table;
+}
+
+constexpr auto KEY_CODES_TABLE = buildKeyCodesTable();
+
+auto getKeyCodeIndex(std::string_view code) -> std::optional<std::size_t> {
+  const auto key_code_idx =
+      KEY_CODES_TABLE[getKeyCodeSlot(code, KEY_CODES_SEED.value())];
+
+  // unsupported code can still land in taken slot
+  if (key_code_idx == EMPTY_SLOT || KEY_CODES.at(key_code_idx) != code) {
+    return std::nullopt;
+  }
+
+  return key_code_idx;
+}
+
+auto getKeyAction(const KeyBindings& bindings, std::string_view code)
+    -> EKeyAction {
+  const auto key_code_idx = getKeyCodeIndex(code);
+
+  return key_code_idx.has_value() ? bindings.actions.at(key_code_idx.value())
+                                  : EKeyAction::None;
+}
+
+auto bindKey(KeyBindings* bindings, std::string_view code, EKeyAction action)
+    -> bool {
+  const auto key_code_idx = getKeyCodeIndex(code);
+
+  if (!key_code_idx.has_value()) {
+    return false;
+  }
+
+  bindings->actions.at(key_code_idx.value()) = action;
+  return true;
+}
+
+auto getKeyActionByName(std::string_view name) -> std::optional<EKeyAction> {
+  if (name == "none") {
+    return EKeyAction::None;
+  }
+  if (name == "turnUp") {
+    return EKeyAction::TurnUp;
+  }
+  if (name == "turnDown") {
+    return EKeyAction::TurnDown;
+  }
+  if (name == "turnLeft") {
+    return EKeyAction::TurnLeft;
+  }
+  if (name == "turnRight") {
+    return EKeyAction::TurnRight;
+  }
+  if (name == "startOrPause") {
+    return EKeyAction::StartOrPause;
+  }
+
+  return std::nullopt;
+}
+
+auto getDefaultKeyBindings() -> KeyBindings {
+  KeyBindings bindings;
+
+  bindKey(&bindings, "ArrowUp", EKeyAction::TurnUp);
+  bindKey(&bindings, "KeyW", EKeyAction::TurnUp);
+  bindKey(&bindings, "ArrowDown", EKeyAction::TurnDown);
+  bindKey(&bindings, "KeyS", EKeyAction::TurnDown);
+  bindKey(&bindings, "ArrowLeft", EKeyAction::TurnLeft);
+  bindKey(&bindings, "KeyA", EKeyAction::TurnLeft);
+  bindKey(&bindings, "ArrowRight", EKeyAction::TurnRight);
+  bindKey(&bindings, "KeyD", EKeyAction::TurnRight);
+  bindKey(&bindings, "Space", EKeyAction::StartOrPause);
+  bindKey(&bindings, "Enter", EKeyAction::StartOrPause);
+
+  return bindings;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "../models/EKeyAction.hpp"
+#include "../models/KeyBindings.hpp"
+
+// index of key code in KEY_CODES, or nothing for unsupported code. takes one
+// hash and one string comparison
+auto getKeyCodeIndex(std::string_view code) -> std::optional<std::size_t>;
+
+auto getKeyAction(const KeyBindings& bindings, std::string_view code)
+    -> EKeyAction;
+
+// returns false when key code is not supported
+auto bindKey(KeyBindings* bindings, std::string_view code, EKeyAction action)
+    -> bool;
+
+auto getKeyActionByName(std::string_view name) -> std::optional<EKeyAction>;
+
+auto getDefaultKeyBindings() -> KeyBindings;
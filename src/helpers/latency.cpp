@@ -0,0 +1,14 @@
+#include "latency.hpp"
+
+#include <algorithm>
+
+void addLatencySample(LatencyHistogram* histogram, double latency) {
+  const auto& bounds = LatencyHistogram::BUCKET_BOUNDS;
+  const auto bucket_idx =
+      std::lower_bound(bounds.begin(), bounds.end(), latency) - bounds.begin();
+
+  histogram->buckets.at(bucket_idx) += 1;
+  histogram->samples_count += 1;
+  histogram->total += latency;
+  histogram->max = std::max(histogram->max, latency);
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "../models/LatencyHistogram.hpp"
+
+void addLatencySample(LatencyHistogram* histogram, double latency);
@@ -0,0 +1,120 @@
+#include "level.hpp"
+
+#include <algorithm>
+
+#include "../models/ECellContent.hpp"
+#include "../models/ECubeSide.hpp"
+#include "../models/EDirection.hpp"
+#include "../models/Grid.hpp"
+
+#ifndef __EMSCRIPTEN__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+auto getLevel(const std::byte* data, std::size_t size) -> std::optional<Level> {
+  // file is viewed as structs in place
+  if (size < sizeof(LevelHeader) ||
+      reinterpret_cast<std::uintptr_t>(data) % alignof(LevelHeader) != 0) {
+    return std::nullopt;
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const auto* header = reinterpret_cast<const LevelHeader*>(data);
+
+  if (header->magic != LEVEL_MAGIC || header->version != LEVEL_VERSION ||
+      header->grid_size < 1 || header->grid_size > MAX_GRID_SIZE ||
+      header->snake_side > static_cast<uint8_t>(ECubeSide::Right) ||
+      header->snake_direction > static_cast<uint8_t>(EDirection::Right) ||
+      header->snake_row >= header->grid_size ||
+      header->snake_col >= header->grid_size) {
+    return std::nullopt;
+  }
+
+  const auto grid_size = std::size_t{header->grid_size};
+  const auto snake_cell_idx =
+      (header->snake_side * grid_size + header->snake_row) * grid_size +
+      header->snake_col;
+
+  const auto cells_count = std::size_t{6} * grid_size * grid_size;
+  const auto zone_size =
+      std::size_t{header->apple_zone_cells_count} * sizeof(uint32_t);
+
+  if (size != sizeof(LevelHeader) + zone_size + cells_count) {
+    return std::nullopt;
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,
+  // cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const Level level{
+      .header = header,
+      .apple_zone_cells = {reinterpret_cast<const uint32_t*>(header + 1),
+                           header->apple_zone_cells_count},
+      .cells = {reinterpret_cast<const uint8_t*>(data) + sizeof(LevelHeader) +
+                    zone_size,
+                cells_count}};
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,
+  // cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  const auto is_terrain = [](uint8_t cell) {
+    return cell == static_cast<uint8_t>(ECellContent::Empty) ||
+           cell == static_cast<uint8_t>(ECellContent::Stone);
+  };
+  const auto is_cell_index = [cells_count](uint32_t cell_idx) {
+    return cell_idx < cells_count;
+  };
+
+  const auto is_empty = [](uint8_t cell) {
+    return cell == static_cast<uint8_t>(ECellContent::Empty);
+  };
+
+  if (!is_empty(level.cells[snake_cell_idx]) ||
+      !std::all_of(level.cells.begin(), level.cells.end(), is_terrain) ||
+      !std::all_of(level.apple_zone_cells.begin(),
+                   level.apple_zone_cells.end(), is_cell_index)) {
+    return std::nullopt;
+  }
+
+  return level;
+}
+
+#ifndef __EMSCRIPTEN__
+
+auto mapLevelFile(const char* path) -> std::optional<MappedLevelFile> {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+  const auto fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    return std::nullopt;
+  }
+
+  const auto size = static_cast<std::size_t>(file_stat.st_size);
+  auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // mapping keeps file open by itself
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    return std::nullopt;
+  }
+
+  return MappedLevelFile{.data = static_cast<const std::byte*>(data),
+                         .size = size};
+}
+
+void unmapLevelFile(MappedLevelFile* file) {
+  if (file->data != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    munmap(const_cast<std::byte*>(file->data), file->size);
+    *file = {};
+  }
+}
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include "../models/Level.hpp"
+
+// checks level file and returns view into it. data has to stay alive and
+// unchanged while level is used. returns nothing for malformed file
+auto getLevel(const std::byte* data, std::size_t size) -> std::optional<Level>;
+
+#ifndef __EMSCRIPTEN__
+
+// level file mapped to memory. pages are loaded lazily by OS, so opening even
+// huge level takes no time
+struct MappedLevelFile {
+  const std::byte* data{nullptr};
+  std::size_t size{0};
+};
+
+auto mapLevelFile(const char* path) -> std::optional<MappedLevelFile>;
+void unmapLevelFile(MappedLevelFile* file);
+
+#endif
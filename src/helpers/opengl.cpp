@@ -1,9 +1,17 @@
 #include "opengl.hpp"
 
-auto initShader(GLenum shader_type, const std::string& shader_src) -> GLuint {
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+
+#include "../platform/platform.hpp"
+#include "assert.hpp"
+
+auto initShader(GLenum shader_type, std::string_view shader_src) -> GLuint {
   auto shader = glCreateShader(shader_type);
-  const char* shader_src_c_str = shader_src.c_str();
-  glShaderSource(shader, 1, &shader_src_c_str, nullptr);
+  const char* shader_src_data = shader_src.data();
+  const auto shader_src_length = static_cast<GLint>(shader_src.size());
+  glShaderSource(shader, 1, &shader_src_data, &shader_src_length);
   glCompileShader(shader);
 
   GLint compile_status{};
@@ -21,7 +29,7 @@ auto initShader(GLenum shader_type, const std::string& shader_src) -> GLuint {
 
     glDeleteShader(shader);
 
-    emscripten_throw_string(error_message.c_str());
+    throwPlatformError(error_message.c_str());
   }
 
   return shader;
@@ -51,7 +59,7 @@ auto initProgram(const std::vector<GLuint>& shaders) -> GLuint {
 
     glDeleteProgram(program);
 
-    emscripten_throw_string(error_message.c_str());
+    throwPlatformError(error_message.c_str());
   }
 
   return program;
@@ -62,7 +70,7 @@ auto getAttributeLocation(GLuint program, const char* attribute_name) -> GLint {
   if (location == -1) {
     const auto error_message =
         std::string{"Failed to get attribute location: "} + attribute_name;
-    emscripten_throw_string(error_message.c_str());
+    throwPlatformError(error_message.c_str());
   }
   return location;
 }
@@ -72,7 +80,150 @@ auto getUniformLocation(GLuint program, const char* uniform_name) -> GLint {
   if (location == -1) {
     const auto error_message =
         std::string{"Failed to get uniform location: "} + uniform_name;
-    emscripten_throw_string(error_message.c_str());
+    throwPlatformError(error_message.c_str());
   }
   return location;
 }
+
+// counts call and tells whether it should be issued
+auto isStateChange(GLStateCache* cache, bool is_change) -> bool {
+  if (is_change) {
+    ++cache->issued_calls_count;
+  } else {
+    ++cache->filtered_calls_count;
+  }
+
+  return is_change;
+}
+
+void useProgram(GLStateCache* cache, GLuint program) {
+  if (isStateChange(cache, cache->program != program)) {
+    glUseProgram(program);
+    cache->program = program;
+  }
+}
+
+void setCapability(GLStateCache* cache, GLenum cap, bool is_enabled) {
+  auto& capabilities = cache->capabilities;
+  auto it = std::find_if(capabilities.begin(), capabilities.end(),
+                         [cap](const auto& c) { return c.cap == cap; });
+
+  const auto is_known = it != capabilities.end();
+  if (!isStateChange(cache, !is_known || it->is_enabled != is_enabled)) {
+    return;
+  }
+
+  if (is_enabled) {
+    glEnable(cap);
+  } else {
+    glDisable(cap);
+  }
+
+  if (!is_known) {
+    capabilities.push_back({.cap = cap, .is_enabled = is_enabled});
+  } else {
+    it->is_enabled = is_enabled;
+  }
+}
+
+void setViewport(GLStateCache* cache, GLint x, GLint y, GLsizei width,
+                 GLsizei height) {
+  const std::array<GLint, 4> viewport{x, y, width, height};
+
+  if (isStateChange(cache, cache->viewport != viewport)) {
+    glViewport(x, y, width, height);
+    cache->viewport = viewport;
+  }
+}
+
+void bindFramebuffer(GLStateCache* cache, GLenum target, GLuint framebuffer) {
+  const auto is_read = target != GL_DRAW_FRAMEBUFFER;
+  const auto is_draw = target != GL_READ_FRAMEBUFFER;
+
+  if (!isStateChange(cache,
+                     (is_read && cache->read_framebuffer != framebuffer) ||
+                         (is_draw && cache->draw_framebuffer != framebuffer))) {
+    return;
+  }
+
+  glBindFramebuffer(target, framebuffer);
+
+  if (is_read) {
+    cache->read_framebuffer = framebuffer;
+  }
+  if (is_draw) {
+    cache->draw_framebuffer = framebuffer;
+  }
+}
+
+// deleting bound framebuffer binds default one, and its name may be reused
+void deleteFramebuffer(GLStateCache* cache, GLuint framebuffer) {
+  glDeleteFramebuffers(1, &framebuffer);
+
+  if (cache->read_framebuffer == framebuffer) {
+    cache->read_framebuffer = 0;
+  }
+  if (cache->draw_framebuffer == framebuffer) {
+    cache->draw_framebuffer = 0;
+  }
+}
+
+void bindTexture(GLStateCache* cache, GLenum unit, GLenum target,
+                 GLuint texture) {
+  if (isStateChange(cache, cache->active_texture_unit != unit)) {
+    glActiveTexture(unit);
+    cache->active_texture_unit = unit;
+  }
+
+  auto& bindings = cache->texture_bindings;
+  auto it = std::find_if(bindings.begin(), bindings.end(), [&](const auto& b) {
+    return b.unit == unit && b.target == target;
+  });
+
+  if (!isStateChange(cache, it == bindings.end() || it->texture != texture)) {
+    return;
+  }
+
+  glBindTexture(target, texture);
+
+  if (it == bindings.end()) {
+    bindings.push_back({.unit = unit, .target = target, .texture = texture});
+  } else {
+    it->texture = texture;
+  }
+}
+
+// deleting bound texture unbinds it, and its name may be reused
+void deleteTexture(GLStateCache* cache, GLuint texture) {
+  glDeleteTextures(1, &texture);
+
+  for (auto& binding : cache->texture_bindings) {
+    if (binding.texture == texture) {
+      binding.texture = 0;
+    }
+  }
+}
+
+void setUniformMatrix4(GLStateCache* cache, GLint location,
+                       const std::array<GLfloat, 4 * 4>& value) {
+  ASSERT(cache->program.has_value());
+  const auto program = cache->program.value();
+
+  auto& matrices = cache->uniform_matrices;
+  auto it = std::find_if(matrices.begin(), matrices.end(), [&](const auto& m) {
+    return m.program == program && m.location == location;
+  });
+
+  if (!isStateChange(cache, it == matrices.end() || it->value != value)) {
+    return;
+  }
+
+  glUniformMatrix4fv(location, 1, GL_FALSE, value.data());
+
+  if (it == matrices.end()) {
+    matrices.push_back(
+        {.program = program, .location = location, .value = value});
+  } else {
+    it->value = value;
+  }
+}
@@ -1,12 +1,35 @@
 #pragma once
 
 #include <GLES2/gl2.h>
-#include <emscripten.h>
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 
-auto initShader(GLenum shader_type, const std::string& shader_src) -> GLuint;
+#include "../models/GLStateCache.hpp"
+
+auto initShader(GLenum shader_type, std::string_view shader_src) -> GLuint;
 auto initProgram(const std::vector<GLuint>& shaders) -> GLuint;
 auto getAttributeLocation(GLuint program, const char* attribute_name) -> GLint;
 auto getUniformLocation(GLuint program, const char* uniform_name) -> GLint;
+
+// state cache. calls which would not change GL state are skipped and counted.
+// state set through cache should not be changed with plain GL calls
+void useProgram(GLStateCache* cache, GLuint program);
+void setCapability(GLStateCache* cache, GLenum cap, bool is_enabled);
+void setViewport(GLStateCache* cache, GLint x, GLint y, GLsizei width,
+                 GLsizei height);
+
+// GL_FRAMEBUFFER target binds both read and draw framebuffers
+void bindFramebuffer(GLStateCache* cache, GLenum target, GLuint framebuffer);
+void deleteFramebuffer(GLStateCache* cache, GLuint framebuffer);
+
+// leaves given unit active, so texture calls which follow go to it
+void bindTexture(GLStateCache* cache, GLenum unit, GLenum target,
+                 GLuint texture);
+void deleteTexture(GLStateCache* cache, GLuint texture);
+
+// of currently used program
+void setUniformMatrix4(GLStateCache* cache, GLint location,
+                       const std::array<GLfloat, 4 * 4>& value);
@@ -1,5 +0,0 @@
-#pragma once
-
-#include <string>
-
-auto read_file_to_string(const std::string& file_path) -> std::string;
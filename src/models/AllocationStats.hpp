@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+struct AllocationCount {
+  int64_t count{0};
+  int64_t bytes{0};
+};
+
+// heap allocations made during one frame, by frame phase
+struct FrameAllocations {
+  // made between frames, ie. in input event handlers
+  AllocationCount input;
+
+  AllocationCount update;
+  AllocationCount cube_drawing;
+};
+
+struct AllocationStats {
+  FrameAllocations last_frame;
+
+  // number of frames which made at least one allocation. should stay still
+  // while game is running
+  int frames_with_allocations{0};
+};
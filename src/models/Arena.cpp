@@ -0,0 +1,67 @@
+#include "Arena.hpp"
+
+#include <algorithm>
+
+Arena::Arena(std::size_t block_size) : block_size{block_size} {
+  blocks.push_back(std::make_unique<std::byte[]>(  // NOLINT(*-avoid-c-arrays)
+      block_size));
+  block_sizes.push_back(block_size);
+}
+
+auto Arena::getChunkSize(std::size_t size) -> std::size_t {
+  // round up, so each chunk keeps max alignment for the next one
+  return (size + CHUNK_ALIGNMENT - 1) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+}
+
+auto Arena::allocate(std::size_t size) -> void* {
+  const auto chunk_size = getChunkSize(size);
+
+  // reuse previously freed chunk of the same size
+  if (chunk_size <= MAX_POOLED_CHUNK_SIZE) {
+    auto& free_list = free_lists.at(chunk_size / CHUNK_ALIGNMENT);
+    if (free_list != nullptr) {
+      auto* chunk = free_list;
+      free_list = chunk->next;
+      return chunk;
+    }
+  }
+
+  // move to next block if current one is full. blocks left from previous
+  // rounds are reused, new ones are only allocated when arena grows
+  while (current_offset + chunk_size > block_sizes[current_block]) {
+    ++current_block;
+    current_offset = 0;
+
+    if (current_block == blocks.size()) {
+      const auto new_block_size = std::max(block_size, chunk_size);
+      blocks.push_back(
+          std::make_unique<std::byte[]>(  // NOLINT(*-avoid-c-arrays)
+              new_block_size));
+      block_sizes.push_back(new_block_size);
+    }
+  }
+
+  auto* ptr = &blocks[current_block][current_offset];
+  current_offset += chunk_size;
+
+  return ptr;
+}
+
+void Arena::deallocate(void* ptr, std::size_t size) {
+  const auto chunk_size = getChunkSize(size);
+
+  // bigger chunks are rare (eg. vector storage), they are not reused until
+  // arena reset
+  if (chunk_size <= MAX_POOLED_CHUNK_SIZE) {
+    auto& free_list = free_lists.at(chunk_size / CHUNK_ALIGNMENT);
+    auto* chunk = static_cast<FreeChunk*>(ptr);
+    chunk->next = free_list;
+    free_list = chunk;
+  }
+}
+
+void Arena::reset() {
+  current_block = 0;
+  current_offset = 0;
+  free_lists.fill(nullptr);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <set>
+#include <vector>
+
+// memory arena for objects which live for one game round.
+//
+// allocates from preallocated blocks by bumping offset, and keeps freed chunks
+// in free lists by size, so node-based containers (set/list), which allocate
+// and free nodes of the same size over and over, reuse arena memory instead of
+// going to global heap. all memory is reclaimed at once with reset(), blocks
+// are kept for the next round, so heap does not get fragmented over long
+// sessions
+class Arena {
+ public:
+  static const std::size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+  // all chunks are aligned for any type
+  static const std::size_t CHUNK_ALIGNMENT = alignof(std::max_align_t);
+
+  explicit Arena(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+  Arena(const Arena&) = delete;
+  auto operator=(const Arena&) -> Arena& = delete;
+
+  auto allocate(std::size_t size) -> void*;
+  void deallocate(void* ptr, std::size_t size);
+
+  // reclaims all memory. containers allocated in arena should be empty by then
+  void reset();
+
+ private:
+  static const std::size_t MAX_POOLED_CHUNK_SIZE = 256;
+
+  struct FreeChunk {
+    FreeChunk* next;
+  };
+
+  static auto getChunkSize(std::size_t size) -> std::size_t;
+
+  std::size_t block_size;
+  std::vector<std::unique_ptr<std::byte[]>> blocks;  // NOLINT(*-avoid-c-arrays)
+  std::vector<std::size_t> block_sizes;
+
+  std::size_t current_block{0};
+  std::size_t current_offset{0};
+
+  std::array<FreeChunk*, MAX_POOLED_CHUNK_SIZE / CHUNK_ALIGNMENT + 1>
+      free_lists{};
+};
+
+// allocator for standard containers which puts them into arena
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  static_assert(alignof(T) <= Arena::CHUNK_ALIGNMENT);
+
+  // containers moved between each other keep their arena
+  using propagate_on_container_move_assignment = std::true_type;
+
+  explicit ArenaAllocator(Arena* arena) : arena{arena} {}
+
+  template <typename U>
+  ArenaAllocator(  // NOLINT(google-explicit-constructor)
+      const ArenaAllocator<U>& other)
+      : arena{other.arena} {}
+
+  auto allocate(std::size_t count) -> T* {
+    return static_cast<T*>(arena->allocate(count * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t count) {
+    arena->deallocate(ptr, count * sizeof(T));
+  }
+
+  template <typename U>
+  auto operator==(const ArenaAllocator<U>& other) const -> bool {
+    return arena == other.arena;
+  }
+
+  Arena* arena;
+};
+
+template <typename T>
+using ArenaList = std::list<T, ArenaAllocator<T>>;
+
+template <typename T>
+using ArenaSet = std::set<T, std::less<T>, ArenaAllocator<T>>;
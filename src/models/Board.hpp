@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "BoardChange.hpp"
+#include "ECellContent.hpp"
+
+// what occupies each cube cell. lets game check and change single cell in O(1)
+// regardless of how many objects are on the cube. entities keep their cells
+// here up to date when they move
+struct Board {
+  // indexed by cell index (see getCellIndex)
+  std::vector<ECellContent> cells;
+
+  // indices of empty cells in no particular order, so random empty cell for
+  // planting is picked in O(1) even when most of the cube is taken
+  std::vector<int> free_cells;
+
+  // position of each cell in free_cells, or -1 when cell is taken
+  std::vector<int> free_cells_positions;
+
+  // entity occupying each cell, or -1 for empty cell, snake or fixed stone
+  std::vector<int> cells_entities;
+
+  int apples_count{0};
+  int stones_count{0};
+
+  // journal of recent cell changes, so they can be undone (see Snapshots).
+  // ring buffer sized by snapshots, change number N is at N % size
+  std::vector<BoardChange> changes;
+  int64_t changes_count{0};
+
+  // bumped when cells change past journal (reset, undo), so journal readers
+  // know to start over
+  int64_t generation{0};
+
+  std::mt19937 random_engine{std::random_device{}()};
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "ECellContent.hpp"
+
+// what setBoardCell has overwritten, so the change can be undone
+struct BoardChange {
+  int cell_idx{0};
+  ECellContent content{};
+
+  // position cell had in free cells list, when change has taken empty cell
+  int free_cells_position{-1};
+};
@@ -2,23 +2,52 @@
 
 #include <GLES2/gl2.h>
 
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <vector>
 
+#include "CubePosition.hpp"
 #include "CubeSide.hpp"
 #include "ECameraMode.hpp"
 #include "Grid.hpp"
 #include "ModelRotation.hpp"
+#include "MultisampleFramebuffer.hpp"
 #include "Point2D.hpp"
+#include "Quaternion.hpp"
 
 struct Cube {
+  using steady_clock = std::chrono::steady_clock;
+  using duration_ms = std::chrono::duration<double, std::milli>;
+
   std::optional<GLuint> program{};
   std::optional<GLint> matrix_uniform_location{};
+  std::optional<GLint> grid_size_uniform_location{};
+
+  // WebGL2 is used when browser supports it, WebGL1 otherwise
+  int webgl_version{1};
+
+  // grid side textures were allocated for. they have texel per cell, so they
+  // are reallocated before next upload when grid changes
+  std::optional<Grid> textures_grid;
+
+  // WebGL1: cell states texture per side
   std::vector<GLuint> textures;
 
-  ModelRotation current_rotation;
+  // WebGL2: cell states texture array with layer per side
+  std::optional<GLuint> texture_array{};
+  std::optional<GLuint> vertex_array{};
+  MultisampleFramebuffer multisample_framebuffer;
+  int max_msaa_samples{0};
+
+  // camera orientation is animated from current to target in quaternions,
+  // while target is set in angles around X and Y axes, which are easier to
+  // reason about for overview spin and mouse control
+  Quaternion current_orientation;
+  Quaternion target_orientation;
   ModelRotation target_rotation;
+  std::optional<std::chrono::time_point<steady_clock>> last_rotation_time{};
 
   ECameraMode camera_mode{ECameraMode::Overview};
 
@@ -27,8 +56,20 @@ struct Cube {
 
   bool needs_redraw{false};
 
-  static const int GRID_SIZE = 16;
-  Grid grid{.rows_count = GRID_SIZE, .cols_count = GRID_SIZE};
+  // board journal position side dirty cells are collected up to
+  int64_t synced_board_generation{-1};
+  int64_t synced_board_changes_count{0};
+
+  // set from game config when round starts
+  Grid grid;
+
+  // target camera rotations when following snake head, by cell index. filled
+  // as snake visits cells, since big grids have too many cells to calculate
+  // all rotations when round starts
+  std::vector<std::optional<ModelRotation>> cell_rotations;
+
+  // snake head which camera target was last calculated for
+  std::optional<CubePosition> followed_head;
 
   std::map<ECubeSide, CubeSide> sides{
       {ECubeSide::Front, CubeSide{.type = ECubeSide::Front}},
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "EDirection.hpp"
+#include "Grid.hpp"
+
+// cells adjacency over cube surface, so searches do not go through cube
+// geometry for each step. directions are local to cell side, the same as for
+// getNextCubePositionAndDirection
+struct CubeGraph {
+  Grid grid;
+
+  // by cell index and direction
+  std::vector<std::array<int, 4>> neighbours;
+
+  // direction which leads from neighbour back to cell, by cell index and
+  // direction to neighbour
+  std::vector<std::array<EDirection, 4>> back_directions;
+};
@@ -1,17 +1,16 @@
 #pragma once
 
-#include <emscripten/val.h>
-
-#include <optional>
+#include <vector>
 
 #include "ECubeSide.hpp"
 
 struct CubeSide {
-  std::optional<emscripten::val> canvas;
-  std::optional<emscripten::val> ctx;
-
   ECubeSide type{};
 
+  // cell states of whole side are uploaded to its texture when set, of dirty
+  // cells only otherwise
   bool needs_redraw{true};
-  bool needs_update_on_cube{true};
+
+  // cell indices which have changed since side was uploaded. may repeat
+  std::vector<int> dirty_cells;
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ECellContent.hpp"
+#include "EDirection.hpp"
+
+// distance (in moves over cube surface) from each cell to the nearest source
+// cell, and direction of the first step towards it. stones block the way,
+// snake does not, since it moves out of the way anyway. kept up to date with
+// board journal, so only cells affected by a change are searched again
+struct DistanceField {
+  static constexpr int BLOCKED = -1;
+  static constexpr int UNREACHABLE = std::numeric_limits<int>::max();
+
+  // cells of this content are sources
+  ECellContent source_content{ECellContent::Apple};
+
+  // by cell index. source cells have 0
+  std::vector<int> distances;
+
+  // local to cell side. meaningless for sources, blocked and unreachable cells
+  std::vector<EDirection> directions;
+
+  // search memory, kept between updates
+  std::vector<int> queue;
+  std::vector<int> seeds;
+
+  // board state field is up to date with
+  int64_t synced_board_generation{-1};
+  int64_t synced_board_changes_count{0};
+};
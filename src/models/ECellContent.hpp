@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdint>
+
+// what is seen in cube cell. also kind of entity occupying the cell
+enum class ECellContent : uint8_t { Empty, Snake, Apple, Stone, SlowDown };
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+enum class EEntityBehaviour : uint8_t {
+  // stays in place until picked up
+  Static,
+
+  // steps to next cell in its direction when timer runs out, turns back when
+  // cell is taken
+  Wander,
+
+  // jumps to random free cell when timer runs out, so it has to be picked up
+  // in time
+  Decay
+};
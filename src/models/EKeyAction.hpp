@@ -0,0 +1,10 @@
+#pragma once
+
+enum class EKeyAction {
+  None,
+  TurnUp,
+  TurnDown,
+  TurnLeft,
+  TurnRight,
+  StartOrPause
+};
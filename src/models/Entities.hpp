@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "CubePosition.hpp"
+#include "ECellContent.hpp"
+#include "EDirection.hpp"
+#include "EEntityBehaviour.hpp"
+
+// objects on cube besides snake and fixed stones (which are board terrain),
+// stored as component arrays, so systems run through each component in one
+// linear pass. entity is index in these arrays. arrays are kept dense: removed
+// entity is replaced with the last one
+struct Entities {
+  std::vector<CubePosition> positions;
+  std::vector<ECellContent> kinds;
+  std::vector<EEntityBehaviour> behaviours;
+
+  // snake moves left until entity behaviour acts next time
+  std::vector<int> timers;
+
+  // where wandering entity steps next
+  std::vector<EDirection> directions;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <optional>
+
+// watches how long frames take and picks quality tier (see QUALITY_TIERS)
+// which fits frame budget. frames are judged in windows of frames which drew
+// something, so idle frames do not look like headroom
+struct FrameGovernor {
+  // better tier is tried after that many windows with headroom. doubled each
+  // time better tier turns out not to fit, so governor does not flip between
+  // tiers
+  static constexpr int MIN_HEADROOM_WINDOWS_NEEDED = 3;
+  static constexpr int MAX_HEADROOM_WINDOWS_NEEDED = 48;
+
+  // index in QUALITY_TIERS
+  int tier{0};
+
+  // without MSAA (WebGL1), tiers which differ only in MSAA look the same, so
+  // they are skipped
+  bool is_msaa_available{true};
+
+  std::optional<double> last_frame_time;
+
+  // current window
+  int frames_count{0};
+  double frame_intervals_sum{0};
+  double frame_work_sum{0};
+  double min_frame_interval{0};
+
+  // averages of previous window, for diagnostics
+  double avg_frame_interval{0};
+  double avg_frame_work{0};
+
+  // frame time aimed at in previous window (ms): 60 fps, or display refresh
+  // interval when rAF comes less often (eg. 50 Hz display, or browser
+  // throttling rAF to 30 fps in low-power mode)
+  double frame_budget{0};
+
+  // windows in a row with enough headroom to try better tier
+  int headroom_windows_count{0};
+  int headroom_windows_needed{MIN_HEADROOM_WINDOWS_NEEDED};
+
+  // windows passed since tier changed last time
+  int windows_since_change{0};
+  bool last_change_was_step_up{false};
+};
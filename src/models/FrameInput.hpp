@@ -0,0 +1,16 @@
+#pragma once
+
+#include <optional>
+
+#include "Point2D.hpp"
+
+// input which can come many times per frame (eg. mice with high polling rate
+// send hundreds of moves), so event handlers only record it here and it is
+// applied once at the start of next frame
+struct FrameInput {
+  // latest mouse position while dragging. rotation depends only on total
+  // mouse offset, so in-between positions are not needed
+  std::optional<Point2D> mouse_pos;
+
+  bool is_resized{false};
+};
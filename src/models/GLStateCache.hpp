@@ -0,0 +1,44 @@
+#pragma once
+
+#include <GLES2/gl2.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// GL state as last set through state cache (see helpers/opengl.hpp). each GL
+// call from wasm crosses into js glue, so calls which would not change state
+// are skipped. unset value means state is unknown, so next call goes through
+struct GLStateCache {
+  struct TextureBinding {
+    GLenum unit;
+    GLenum target;
+    GLuint texture;
+  };
+
+  struct Capability {
+    GLenum cap;
+    bool is_enabled;
+  };
+
+  struct UniformMatrix4 {
+    GLuint program;
+    GLint location;
+    std::array<GLfloat, 4 * 4> value;
+  };
+
+  std::optional<GLuint> program;
+  std::optional<GLenum> active_texture_unit;
+  std::optional<std::array<GLint, 4>> viewport;
+  std::optional<GLuint> read_framebuffer;
+  std::optional<GLuint> draw_framebuffer;
+
+  // few entries, added on first use, so linear search is enough
+  std::vector<TextureBinding> texture_bindings;
+  std::vector<Capability> capabilities;
+  std::vector<UniformMatrix4> uniform_matrices;
+
+  int64_t issued_calls_count{0};
+  int64_t filtered_calls_count{0};
+};
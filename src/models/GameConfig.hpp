@@ -0,0 +1,31 @@
+#pragma once
+
+// settings of game round. changes apply when next round starts
+struct GameConfig {
+  // cells per cube side edge
+  int grid_size{16};
+
+  int apples_count{10};
+
+  // plant new apple each time one is eaten, so round goes on until crash
+  bool respawn_apples{false};
+
+  int stones_count{10};
+
+  // share of all cells covered with stones, eg. 0.3 for maze-like rounds.
+  // overrides stones count when set
+  double stones_density{0};
+
+  int wandering_stones_count{0};
+
+  // apples which jump elsewhere when not picked up in time. they count as
+  // usual apples for respawn and win
+  int decaying_apples_count{0};
+
+  // power-ups which slow snake down
+  int slow_downs_count{0};
+
+  // practice mode: crash rewinds round a few moves back and pauses it instead
+  // of ending it
+  bool rewind_on_crash{false};
+};
@@ -1,18 +1,59 @@
 #pragma once
 
-#include <set>
+#include <optional>
 
+#include "Arena.hpp"
+#include "Board.hpp"
+#include "CubeGraph.hpp"
 #include "CubePosition.hpp"
+#include "DistanceField.hpp"
 #include "EGameStatus.hpp"
+#include "Entities.hpp"
+#include "FrameInput.hpp"
+#include "GameConfig.hpp"
+#include "KeyBindings.hpp"
+#include "Level.hpp"
 #include "Scene.hpp"
 #include "Snake.hpp"
+#include "Snapshots.hpp"
+#include "Stats.hpp"
 
 struct GameState {
+  // memory for objects which live for one game round, so starting new round
+  // reclaims it at once. declared first, so it outlives containers using it
+  Arena round_arena;
+
   Scene scene;
 
-  Snake snake;
-  std::set<CubePosition> apples{};
-  std::set<CubePosition> stones{};
+  Snake snake{.parts = ArenaList<CubePosition>{
+                  ArenaAllocator<CubePosition>{&round_arena}}};
+
+  // snake, apples and stones per cell
+  Board board;
+
+  Entities entities;
+
+  // set from grid when round starts
+  CubeGraph cube_graph;
+
+  // read through syncDistanceField, which brings it up to date lazily
+  DistanceField apple_distances{.source_content = ECellContent::Apple};
+
+  Snapshots snapshots;
+
+  GameConfig config;
+
+  // handcrafted level to plant objects from instead of random planting
+  std::optional<Level> level;
+
+  // level set through api. like config, it applies when next round starts,
+  // so round in progress keeps its grid and apple zones
+  std::optional<Level> next_level;
 
   EGameStatus status{EGameStatus::Welcome};
+
+  KeyBindings key_bindings;
+  FrameInput input;
+
+  Stats stats;
 };
@@ -1,6 +1,13 @@
 #pragma once
 
+// limit of cells per cube side edge, for configs and levels alike. board,
+// journal and search memory grow with its square, and cells count has to fit
+// int
+constexpr int MAX_GRID_SIZE = 1024;
+
 struct Grid {
   int rows_count{};
   int cols_count{};
+
+  auto operator==(const Grid& other) const -> bool = default;
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <optional>
+
+#include "ECubeSide.hpp"
+
+// timestamps (ms) of stages which key press goes through before its result
+// appears on screen. all timestamps are in the same time base as DOM event
+// timestamps and animation frame times (ie. performance.now())
+struct InputTrace {
+  double key_time{};
+  double move_time{};
+  std::optional<double> texture_upload_time;
+
+  // cube side which received new snake head after move
+  ECubeSide side{};
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "EKeyAction.hpp"
+
+// keyboard event codes (layout independent physical keys) which can be bound
+// to actions. codes are looked up through perfect hash built from this list at
+// compile time, so keep it short enough for hash seed to be found
+constexpr std::array<std::string_view, 51> KEY_CODES{
+    "KeyA",       "KeyB",         "KeyC",        "KeyD",      "KeyE",
+    "KeyF",       "KeyG",         "KeyH",        "KeyI",      "KeyJ",
+    "KeyK",       "KeyL",         "KeyM",        "KeyN",      "KeyO",
+    "KeyP",       "KeyQ",         "KeyR",        "KeyS",      "KeyT",
+    "KeyU",       "KeyV",         "KeyW",        "KeyX",      "KeyY",
+    "KeyZ",       "Digit0",       "Digit1",      "Digit2",    "Digit3",
+    "Digit4",     "Digit5",       "Digit6",      "Digit7",    "Digit8",
+    "Digit9",     "ArrowUp",      "ArrowDown",   "ArrowLeft", "ArrowRight",
+    "Space",      "Enter",        "Escape",      "Tab",       "Backspace",
+    "ShiftLeft",  "ShiftRight",   "ControlLeft", "AltLeft",   "AltRight",
+    "ControlRight"};
+
+struct KeyBindings {
+  // action per key code, indexed the same as KEY_CODES
+  std::array<EKeyAction, KEY_CODES.size()> actions{};
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <array>
+
+struct LatencyHistogram {
+  // upper bounds (ms) of histogram buckets. last bucket is for samples above
+  // the last bound
+  static constexpr std::array<double, 10> BUCKET_BOUNDS{1,  2,  4,   8,   16,
+                                                        32, 64, 128, 256, 512};
+
+  std::array<int, BUCKET_BOUNDS.size() + 1> buckets{};
+
+  int samples_count{0};
+  double total{0};
+  double max{0};
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// binary level file, little endian:
+//
+//   LevelHeader
+//   uint32_t apple_zone_cells[apple_zone_cells_count]  cells apples grow in
+//   uint8_t cells[6 * grid_size * grid_size]           ECellContent, only
+//                                                      Empty or Stone
+//
+// cells are indexed the same way as on board (see getCellIndex). all fields
+// are fixed-size and aligned, so file is used in place right in memory it was
+// mapped or loaded to
+constexpr uint32_t LEVEL_MAGIC = 0x4C4B4E53;  // "SNKL"
+constexpr uint16_t LEVEL_VERSION = 1;
+
+struct LevelHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t grid_size;
+
+  // snake start
+  uint8_t snake_side;       // ECubeSide
+  uint8_t snake_direction;  // EDirection
+  uint16_t snake_row;
+  uint16_t snake_col;
+  uint16_t reserved;
+
+  // apples planted at start, in random cells of apple zones
+  uint32_t apples_count;
+  uint32_t apple_zone_cells_count;
+};
+
+static_assert(sizeof(LevelHeader) == 24);
+static_assert(alignof(LevelHeader) == alignof(uint32_t));
+
+// validated level, pointing into level file memory
+struct Level {
+  const LevelHeader* header;
+  std::span<const uint32_t> apple_zone_cells;
+  std::span<const uint8_t> cells;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <GLES2/gl2.h>
+
+// offscreen framebuffer cube is drawn to when MSAA is on, then resolved to
+// canvas. unlike context antialiasing, it can be turned on and off at any time
+struct MultisampleFramebuffer {
+  GLuint framebuffer{0};
+  GLuint color_renderbuffer{0};
+  GLuint depth_renderbuffer{0};
+
+  // 0 when there is no framebuffer
+  int samples{0};
+  int width{0};
+  int height{0};
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include "../platform/platform.hpp"
+#include "EGameStatus.hpp"
+#include "Size.hpp"
+
+// status overlay is a separate canvas on top of scene canvas. browser
+// composites it over cube, so status changes do not touch cube sides, and
+// showing or hiding overlay costs a style change
+struct Overlay {
+  // by status, created and rendered on first show. in game there is no overlay
+  std::array<std::optional<Canvas>, 5> canvases;
+  std::array<bool, 5> is_rendered{};
+
+  // css size and pixel ratio overlays were rendered for
+  Size css_size;
+  double pixel_ratio{1};
+
+  std::optional<EGameStatus> shown_status;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <array>
+
+struct QualityTier {
+  // share of css size x devicePixelRatio used for canvas backing store.
+  // browser stretches canvas to css size
+  double render_scale;
+
+  // WebGL2 only. WebGL1 antialiasing is set once on context creation
+  int msaa_samples;
+};
+
+// from best to cheapest
+constexpr std::array<QualityTier, 4> QUALITY_TIERS{{
+    {.render_scale = 1, .msaa_samples = 4},
+    {.render_scale = 1, .msaa_samples = 0},
+    {.render_scale = 0.75, .msaa_samples = 0},
+    {.render_scale = 0.5, .msaa_samples = 0},
+}};
@@ -0,0 +1,11 @@
+#pragma once
+
+// unit quaternion describing orientation in 3D space
+struct Quaternion {
+  double w{1};
+  double x{};
+  double y{};
+  double z{};
+
+  auto operator==(const Quaternion& other) const -> bool = default;
+};
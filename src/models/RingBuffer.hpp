@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+// fixed-capacity FIFO queue on top of plain array, so pushing/popping items
+// never touches the heap
+template <typename T, std::size_t Capacity>
+class RingBuffer {
+ public:
+  auto push(const T& item) -> bool {
+    if (full()) {
+      return false;
+    }
+
+    items[(first + count) % Capacity] = item;
+    ++count;
+    return true;
+  }
+
+  auto pop() -> std::optional<T> {
+    if (empty()) {
+      return std::nullopt;
+    }
+
+    auto item = items[first];
+    first = (first + 1) % Capacity;
+    --count;
+    return item;
+  }
+
+  void clear() {
+    first = 0;
+    count = 0;
+  }
+
+  [[nodiscard]] auto front() const -> const T& { return items[first]; }
+  [[nodiscard]] auto back() const -> const T& {
+    return items[(first + count - 1) % Capacity];
+  }
+
+  [[nodiscard]] auto empty() const -> bool { return count == 0; }
+  [[nodiscard]] auto full() const -> bool { return count == Capacity; }
+  [[nodiscard]] auto size() const -> std::size_t { return count; }
+
+ private:
+  std::array<T, Capacity> items{};
+  std::size_t first{0};
+  std::size_t count{0};
+};
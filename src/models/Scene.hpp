@@ -1,14 +1,24 @@
 #pragma once
 
-#include <emscripten/val.h>
-
 #include <optional>
 
+#include "../platform/platform.hpp"
 #include "Cube.hpp"
+#include "FrameGovernor.hpp"
+#include "GLStateCache.hpp"
+#include "Overlay.hpp"
+#include "Size.hpp"
 
 struct Scene {
-  std::optional<emscripten::val> canvas;
-  std::optional<emscripten::val> ctx;
+  std::optional<Canvas> canvas;
+  GLStateCache gl_state;
+
+  // canvas size on page. backing store size also depends on quality tier
+  Size css_size;
+  double pixel_ratio{1};
+
+  FrameGovernor frame_governor;
 
   Cube cube;
+  Overlay overlay;
 };
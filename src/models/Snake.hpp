@@ -1,20 +1,32 @@
 #pragma once
 
 #include <chrono>
-#include <list>
 #include <optional>
 
+#include "Arena.hpp"
 #include "CubePosition.hpp"
 #include "ECubeSide.hpp"
 #include "EDirection.hpp"
+#include "RingBuffer.hpp"
+#include "SnakeTurn.hpp"
 
 struct Snake {
   using steady_clock = std::chrono::steady_clock;
   using duration_ms = std::chrono::duration<double, std::milli>;
 
+  // turns requested faster than snake moves are queued instead of overwriting
+  // each other, and then applied one per move
+  static const int TURNS_QUEUE_CAPACITY = 3;
+
   std::optional<std::chrono::time_point<steady_clock>> last_move_time{};
-  std::list<CubePosition> parts{{ECubeSide::Front, 0, 0}};
+
+  // allocated in round arena, so list cannot be default-constructed here.
+  // initial part is added when snake is planted
+  ArenaList<CubePosition> parts;
+
   EDirection direction{EDirection::Right};
-  duration_ms move_period{150};
+  RingBuffer<SnakeTurn, TURNS_QUEUE_CAPACITY> pending_turns;
+  static constexpr duration_ms INITIAL_MOVE_PERIOD{150};
+  duration_ms move_period{INITIAL_MOVE_PERIOD};
   bool is_crashed{false};
 };
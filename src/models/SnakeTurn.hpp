@@ -0,0 +1,10 @@
+#pragma once
+
+#include "EDirection.hpp"
+
+struct SnakeTurn {
+  EDirection direction{};
+
+  // timestamp (ms) of key press event which requested this turn
+  double key_time{};
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+#include "CubePosition.hpp"
+#include "EDirection.hpp"
+#include "Entities.hpp"
+#include "RingBuffer.hpp"
+#include "Snake.hpp"
+#include "SnakeTurn.hpp"
+
+// state after some tick which ticks do not journal: entities (which change
+// every tick anyway), random engine and snake scalars. board and snake parts
+// are restored by undoing journaled changes, so keyframe cost does not grow
+// with grid size or snake length
+struct SnapshotKeyframe {
+  // -1 for slot which holds nothing yet
+  int tick{-1};
+
+  EDirection snake_direction{};
+  RingBuffer<SnakeTurn, Snake::TURNS_QUEUE_CAPACITY> pending_turns;
+  Snake::duration_ms move_period{};
+  bool is_crashed{false};
+
+  std::mt19937 random_engine;
+
+  Entities entities;
+};
+
+// what tick has taken as input, and what it has changed
+struct SnapshotDelta {
+  // simulation is deterministic, so the only input of tick besides state
+  // before it is turns player has queued by then
+  RingBuffer<SnakeTurn, Snake::TURNS_QUEUE_CAPACITY> pending_turns;
+
+  // snake moves by moving tail to new head, then grows by doubling tail
+  CubePosition snake_tail;
+  int snake_growth{0};
+
+  // range of board changes journal
+  int64_t board_changes_start{0};
+  int64_t board_changes_end{0};
+};
+
+// recent ticks of current round, for rewinding and resimulating. tick is
+// restored by undoing later ticks back to the closest keyframe before it, and
+// replaying ticks from there, so restore costs at most DELTAS_COUNT undone and
+// KEYFRAME_INTERVAL replayed ticks. all slots are allocated up front, and
+// reused from round to round
+struct Snapshots {
+  static const int KEYFRAME_INTERVAL = 32;
+  static const int KEYFRAMES_COUNT = 8;
+  static const int DELTAS_COUNT = KEYFRAME_INTERVAL * KEYFRAMES_COUNT;
+
+  // snake moves since round start
+  int tick{0};
+
+  // oldest tick which still can be restored
+  int first_tick{0};
+
+  // by tick / KEYFRAME_INTERVAL % KEYFRAMES_COUNT
+  std::array<SnapshotKeyframe, KEYFRAMES_COUNT> keyframes;
+
+  // by tick % DELTAS_COUNT
+  std::array<SnapshotDelta, DELTAS_COUNT> deltas;
+
+  // set while ticks are replayed, so they do not count as player input
+  bool is_replaying{false};
+};
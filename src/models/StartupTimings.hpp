@@ -0,0 +1,16 @@
+#pragma once
+
+// durations (ms) of startup phases, to track time to first frame
+struct StartupTimings {
+  // from page navigation start to the moment game starts initializing. covers
+  // downloading, compiling and instantiating wasm module
+  double wasm_instantiate{};
+
+  double context_creation{};
+  double shaders_compilation{};
+  double first_texture_upload{};
+  double first_frame{};
+
+  // from page navigation start to the end of first frame
+  double total{};
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <optional>
+
+#include "AllocationStats.hpp"
+#include "InputTrace.hpp"
+#include "LatencyHistogram.hpp"
+#include "StartupTimings.hpp"
+
+struct Stats {
+  int frames_count{0};
+
+  StartupTimings startup;
+
+  // key press which is currently on its way to the screen
+  std::optional<InputTrace> input_trace;
+
+  // latencies between input trace stages. split by stages to see whether
+  // input lag comes from waiting for next snake move, uploading cell states
+  // of cube side or waiting for next frame
+  LatencyHistogram key_to_move;
+  LatencyHistogram move_to_texture_upload;
+  LatencyHistogram texture_upload_to_present;
+  LatencyHistogram key_to_present;
+
+  AllocationStats allocations;
+};
@@ -0,0 +1,93 @@
+#ifndef __EMSCRIPTEN__
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <array>
+#include <chrono>
+#include <stdexcept>
+
+#include "../helpers/assert.hpp"
+#include "platform.hpp"
+
+auto getNow() -> double {
+  using duration_ms = std::chrono::duration<double, std::milli>;
+  return duration_ms(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void throwPlatformError(const char* message) {
+  throw std::runtime_error(message);
+}
+
+auto getCanvasSize(const Canvas& canvas) -> Size {
+  return {.width = static_cast<double>(canvas.width),
+          .height = static_cast<double>(canvas.height)};
+}
+
+// surfaceless display needs neither window system nor GPU, so it runs on
+// Mesa software rasterizers (llvmpipe). display of default platform is tried
+// when EGL does not support surfaceless one
+auto getEglDisplay() -> EGLDisplay {
+  auto display = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                       EGL_DEFAULT_DISPLAY, nullptr);
+
+  if (display == EGL_NO_DISPLAY) {
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  }
+  ASSERT(display != EGL_NO_DISPLAY);
+
+  return display;
+}
+
+// pbuffer of canvas size stands for canvas, so default framebuffer is there
+// as in browser
+auto createGraphicsContext(const Canvas& canvas) -> int {
+  auto display = getEglDisplay();
+  ASSERT(eglInitialize(display, nullptr, nullptr) == EGL_TRUE);
+  ASSERT(eglBindAPI(EGL_OPENGL_ES_API) == EGL_TRUE);
+
+  for (const int version : {2, 1}) {
+    if (version + 1 > canvas.max_gles_version) {
+      continue;
+    }
+
+    const std::array<EGLint, 15> config_attrs{
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,
+        version == 2 ? EGL_OPENGL_ES3_BIT : EGL_OPENGL_ES2_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8, EGL_DEPTH_SIZE, 24, EGL_NONE};
+
+    EGLConfig config{};
+    EGLint configs_count{};
+    if (eglChooseConfig(display, config_attrs.data(), &config, 1,
+                        &configs_count) != EGL_TRUE ||
+        configs_count == 0) {
+      continue;
+    }
+
+    // GLES3 for WebGL2 path, GLES2 for WebGL1 one
+    const std::array<EGLint, 3> context_attrs{EGL_CONTEXT_MAJOR_VERSION,
+                                              version + 1, EGL_NONE};
+    auto context = eglCreateContext(display, config, EGL_NO_CONTEXT,
+                                    context_attrs.data());
+    if (context == EGL_NO_CONTEXT) {
+      continue;
+    }
+
+    const std::array<EGLint, 5> surface_attrs{
+        EGL_WIDTH, canvas.width, EGL_HEIGHT, canvas.height, EGL_NONE};
+    auto surface =
+        eglCreatePbufferSurface(display, config, surface_attrs.data());
+    ASSERT(surface != EGL_NO_SURFACE);
+
+    ASSERT(eglMakeCurrent(display, surface, surface, context) == EGL_TRUE);
+
+    return version;
+  }
+
+  throwPlatformError("Failed to create GLES context");
+}
+
+#endif
@@ -0,0 +1,60 @@
+#ifdef __EMSCRIPTEN__
+
+#include <GLES2/gl2.h>
+#include <emscripten.h>
+#include <emscripten/html5_webgl.h>
+
+#include "../helpers/assert.hpp"
+#include "platform.hpp"
+
+auto getNow() -> double { return emscripten_get_now(); }
+
+void throwPlatformError(const char* message) {
+  emscripten_throw_string(message);
+}
+
+auto getCanvasSize(const Canvas& canvas) -> Size {
+  return {.width = canvas["width"].as<double>(),
+          .height = canvas["height"].as<double>()};
+}
+
+// using GLES2 API to draw 3D since it's basically the same as webgl API.
+// alternatively emscripten has static bindings for webgl (too long func names
+// due to "emscripten_" prefix) or SDL (totally different API)
+auto createGraphicsContext(const Canvas& /*canvas*/) -> int {
+  EmscriptenWebGLContextAttributes attrs{
+      .alpha = GL_TRUE,
+      .depth = GL_TRUE,
+      .stencil = GL_FALSE,
+      // WebGL2 draws to its own multisampled framebuffer, so MSAA can be
+      // turned off when frames do not fit budget
+      .antialias = GL_FALSE,
+      .premultipliedAlpha = GL_TRUE,
+      .preserveDrawingBuffer = GL_FALSE,
+      .powerPreference = EM_WEBGL_POWER_PREFERENCE_DEFAULT,
+      .failIfMajorPerformanceCaveat = GL_FALSE,
+      .majorVersion = 2,
+      .minorVersion = 0};
+
+  // prefer WebGL2, and fall back to WebGL1 if browser does not support it
+  auto ctx_handle = emscripten_webgl_create_context("canvas", &attrs);
+  if (ctx_handle <= 0) {
+    attrs.majorVersion = 1;
+    attrs.antialias = GL_TRUE;
+    ctx_handle = emscripten_webgl_create_context("canvas", &attrs);
+  }
+  ASSERT(ctx_handle > 0);
+
+  emscripten_webgl_make_context_current(ctx_handle);
+
+  // WebGL1 shader computes grid lines from derivatives (WebGL2 has them
+  // built in)
+  if (attrs.majorVersion == 1) {
+    ASSERT(emscripten_webgl_enable_extension(
+        ctx_handle, "OES_standard_derivatives"));
+  }
+
+  return attrs.majorVersion;
+}
+
+#endif
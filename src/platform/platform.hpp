@@ -0,0 +1,39 @@
+#pragma once
+
+// thin layer over what differs between browser build and native headless
+// build (see bench/). drawing itself is plain GLES in both, so it does not go
+// through here
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+#include "../models/Size.hpp"
+
+#ifdef __EMSCRIPTEN__
+// canvas element is js object reached via embind
+using Canvas = emscripten::val;
+#else
+// there are no canvas elements natively, only drawing surface of that size
+struct Canvas {
+  int width{};
+  int height{};
+
+  // highest GLES major version to try, 2 forces WebGL1 path
+  int max_gles_version{3};
+};
+#endif
+
+// ms since arbitrary point in the past, with sub-ms precision
+auto getNow() -> double;
+
+// reports error to host (js exception in browser) and does not return
+[[noreturn]] void throwPlatformError(const char* message);
+
+// backing store size (px)
+auto getCanvasSize(const Canvas& canvas) -> Size;
+
+// creates GL context drawing to scene canvas and makes it current. prefers
+// WebGL2 and falls back to WebGL1. returns 2 for WebGL2 (GLES3), 1 for WebGL1
+// (GLES2)
+auto createGraphicsContext(const Canvas& canvas) -> int;
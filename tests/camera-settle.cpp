@@ -0,0 +1,53 @@
+// rotates camera from random orientations to random targets and checks that
+// it comes to rest: once target is reached, frames stop asking for redraw
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+#include "../src/actions/cube-actions.hpp"
+#include "../src/helpers/graphics-math.hpp"
+
+const int ROTATIONS_COUNT = 1000;
+const int MAX_FRAMES_COUNT = 600;
+const double FRAME_SECONDS = 1.0 / 60;
+
+auto main() -> int {
+  std::mt19937 random_engine{1};
+  std::uniform_real_distribution<double> random_angle{0, 360};
+  const auto getRandomOrientation = [&] {
+    return getQuaternionForRotation(
+        {.x = random_angle(random_engine), .y = random_angle(random_engine)});
+  };
+
+  auto cube = std::make_unique<Cube>();
+  int max_frames_count = 0;
+
+  for (int i = 0; i < ROTATIONS_COUNT; ++i) {
+    cube->current_orientation = getRandomOrientation();
+    cube->target_orientation = getRandomOrientation();
+
+    int frames_count = 0;
+    do {
+      cube->needs_redraw = false;
+      rotateCameraToTarget(cube.get(), FRAME_SECONDS);
+      frames_count += 1;
+    } while (cube->needs_redraw && frames_count < MAX_FRAMES_COUNT);
+
+    if (cube->needs_redraw ||
+        cube->current_orientation != cube->target_orientation) {
+      std::printf("FAILED: rotation %d has not come to rest in %d frames\n", i,
+                  MAX_FRAMES_COUNT);
+      return EXIT_FAILURE;
+    }
+
+    max_frames_count = std::max(max_frames_count, frames_count);
+  }
+
+  std::printf("ok: %d rotations came to rest in %d frames at most\n",
+              ROTATIONS_COUNT, max_frames_count);
+
+  return EXIT_SUCCESS;
+}
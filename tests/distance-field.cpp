@@ -0,0 +1,119 @@
+// plays random rounds with wandering stones, decaying apples and rewinds, and
+// checks after each sync that apple distance field kept up to date with board
+// journal matches the one searched from scratch. syncs come after a random
+// number of ticks, so they apply single changes as well as batches of them
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+#include "../src/actions/game-actions.hpp"
+#include "../src/actions/snake-actions.hpp"
+#include "../src/actions/snapshot-actions.hpp"
+#include "../src/helpers/distance-field.hpp"
+
+const int TICKS_COUNT = 20000;
+const int MAX_TICKS_BETWEEN_SYNCS = 4;
+const int REWIND_PERIOD = 50;  // ticks, on average
+const int MAX_REWIND_TICKS_COUNT = 40;
+const int TURN_PERIOD = 4;  // ticks, on average
+
+// synced field can take other first step than searched one when there are
+// several shortest paths, so directions are checked to lead one step closer
+auto getMismatchedCell(const DistanceField& synced,
+                       const DistanceField& searched, const CubeGraph& graph)
+    -> int {
+  for (int cell_idx = 0; cell_idx < static_cast<int>(synced.distances.size());
+       ++cell_idx) {
+    const auto distance = synced.distances[cell_idx];
+    if (distance != searched.distances[cell_idx]) {
+      return cell_idx;
+    }
+
+    if (distance <= 0 || distance == DistanceField::UNREACHABLE) {
+      continue;
+    }
+
+    const auto direction = static_cast<int>(synced.directions[cell_idx]);
+    const auto next_idx = graph.neighbours[cell_idx][direction];
+    if (synced.distances[next_idx] != distance - 1) {
+      return cell_idx;
+    }
+  }
+
+  return -1;
+}
+
+auto main() -> int {
+  auto state = std::make_unique<GameState>();
+  state->board.random_engine.seed(1);
+  state->config = {.grid_size = 12,
+                   .apples_count = 15,
+                   .respawn_apples = true,
+                   .stones_count = 20,
+                   .wandering_stones_count = 10,
+                   .decaying_apples_count = 10};
+
+  initGameState(state.get());
+  startOrPauseGame(state.get());
+
+  std::mt19937 random_engine{1};
+  const auto is_chance = [&random_engine](int period) {
+    return std::uniform_int_distribution{1, period}(random_engine) == 1;
+  };
+
+  DistanceField synced{.source_content = ECellContent::Apple};
+  DistanceField searched{.source_content = ECellContent::Apple};
+
+  int syncs_count = 0;
+  int rewinds_count = 0;
+  int rounds_count = 1;
+
+  for (int i = 0; i < TICKS_COUNT; ++i) {
+    if (is_chance(TURN_PERIOD)) {
+      const auto direction = static_cast<EDirection>(
+          std::uniform_int_distribution{0, 3}(random_engine));
+      queueSnakeTurn(state.get(), direction, 0);
+    }
+
+    playTick(state.get());
+
+    if (is_chance(REWIND_PERIOD)) {
+      const auto ticks_count =
+          std::uniform_int_distribution{1, MAX_REWIND_TICKS_COUNT}(
+              random_engine);
+      if (restoreSnapshot(state.get(), state->snapshots.tick - ticks_count)) {
+        rewinds_count += 1;
+      }
+    }
+
+    if (state->snake.is_crashed || state->board.apples_count == 0) {
+      plantObjects(state.get());
+      rounds_count += 1;
+    }
+
+    if (!is_chance(MAX_TICKS_BETWEEN_SYNCS)) {
+      continue;
+    }
+
+    syncDistanceField(&synced, state->cube_graph, state->board);
+    resetDistanceField(&searched, state->cube_graph, state->board);
+    syncs_count += 1;
+
+    const auto cell_idx =
+        getMismatchedCell(synced, searched, state->cube_graph);
+    if (cell_idx >= 0) {
+      std::printf("FAILED at tick %d: cell %d has distance %d, expected %d\n",
+                  i, cell_idx, synced.distances[cell_idx],
+                  searched.distances[cell_idx]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::printf("ok: %d syncs matched search from scratch over %d ticks, %d "
+              "rounds, %d rewinds\n",
+              syncs_count, TICKS_COUNT, rounds_count, rewinds_count);
+
+  return EXIT_SUCCESS;
+}
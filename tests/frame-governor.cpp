@@ -0,0 +1,108 @@
+// feeds frame governor with synthetic frames and checks which tiers it goes
+// through. janky frames alternate between one and two display refreshes
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../src/helpers/frame-governor.hpp"
+
+const int FRAMES_COUNT = 3000;
+
+struct Scenario {
+  const char* name;
+  bool is_msaa_available;
+  int start_tier;
+
+  // frames alternate between these intervals (ms)
+  double frame_interval_a;
+  double frame_interval_b;
+
+  // main thread time per frame (ms)
+  double frame_work;
+
+  std::vector<int> expected_tiers;
+};
+
+const std::array<Scenario, 7> SCENARIOS{{
+    {.name = "busy janky frames at 60 Hz",
+     .is_msaa_available = true,
+     .frame_interval_a = 16.7,
+     .frame_interval_b = 33.3,
+     .frame_work = 14,
+     .expected_tiers = {1, 2, 3}},
+    {.name = "same without MSAA",
+     .is_msaa_available = false,
+     .frame_interval_a = 16.7,
+     .frame_interval_b = 33.3,
+     .frame_work = 14,
+     .expected_tiers = {2, 3}},
+    {.name = "idle janky frames at 60 Hz",
+     .is_msaa_available = true,
+     .frame_interval_a = 16.7,
+     .frame_interval_b = 33.3,
+     .frame_work = 2,
+     .expected_tiers = {}},
+    {.name = "rAF throttled to 30 fps",
+     .is_msaa_available = true,
+     .frame_interval_a = 33.3,
+     .frame_interval_b = 33.3,
+     .frame_work = 2,
+     .expected_tiers = {}},
+    {.name = "busy frames on time at 50 Hz",
+     .is_msaa_available = true,
+     .frame_interval_a = 20,
+     .frame_interval_b = 20,
+     .frame_work = 14,
+     .expected_tiers = {}},
+    {.name = "headroom at 60 Hz",
+     .is_msaa_available = true,
+     .start_tier = 3,
+     .frame_interval_a = 16.7,
+     .frame_interval_b = 16.7,
+     .frame_work = 2,
+     .expected_tiers = {2, 1, 0}},
+    {.name = "same without MSAA",
+     .is_msaa_available = false,
+     .start_tier = 2,
+     .frame_interval_a = 16.7,
+     .frame_interval_b = 16.7,
+     .frame_work = 2,
+     .expected_tiers = {0}},
+}};
+
+auto main() -> int {
+  auto is_passed = true;
+
+  for (const auto& scenario : SCENARIOS) {
+    FrameGovernor governor{.tier = scenario.start_tier,
+                           .is_msaa_available = scenario.is_msaa_available};
+    std::vector<int> tiers;
+
+    double frame_time = 0;
+    for (int i = 0; i < FRAMES_COUNT; ++i) {
+      frame_time += i % 2 == 0 ? scenario.frame_interval_a
+                               : scenario.frame_interval_b;
+
+      const auto tier =
+          addFrameSample(&governor, frame_time, scenario.frame_work, true);
+      if (tier.has_value()) {
+        tiers.push_back(tier.value());
+      }
+    }
+
+    const auto is_scenario_passed = tiers == scenario.expected_tiers;
+
+    std::printf("%-28s %s: tiers", scenario.name,
+                is_scenario_passed ? "ok" : "FAILED");
+    for (const auto tier : tiers) {
+      std::printf(" %d", tier);
+    }
+    std::printf(", budget %.1f ms\n", governor.frame_budget);
+
+    is_passed = is_passed && is_scenario_passed;
+  }
+
+  return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
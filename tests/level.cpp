@@ -0,0 +1,181 @@
+// writes generated level file on big grid, maps it and checks that it is
+// accepted while truncated and corrupted copies of it are not. then starts
+// rounds from mapped level and times how long planting objects takes
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../src/actions/game-actions.hpp"
+#include "../src/helpers/level.hpp"
+#include "../src/models/ECellContent.hpp"
+#include "../src/platform/platform.hpp"
+
+const uint16_t GRID_SIZE = 256;
+const double STONES_DENSITY = 0.2;
+const uint32_t APPLES_COUNT = 500;
+const int ROUNDS_COUNT = 20;
+
+auto createLevelFile() -> std::vector<std::byte> {
+  const auto cells_count = std::size_t{6} * GRID_SIZE * GRID_SIZE;
+
+  std::mt19937 random_engine{1};
+  std::bernoulli_distribution is_stone{STONES_DENSITY};
+
+  std::vector<uint8_t> cells(cells_count);
+  std::vector<uint32_t> apple_zone_cells;
+  for (std::size_t cell_idx = 0; cell_idx < cells_count; ++cell_idx) {
+    // snake starts at first cell
+    if (cell_idx > 0 && is_stone(random_engine)) {
+      cells[cell_idx] = static_cast<uint8_t>(ECellContent::Stone);
+    } else if (cell_idx % 7 == 0) {
+      apple_zone_cells.push_back(cell_idx);
+    }
+  }
+
+  const LevelHeader header{
+      .magic = LEVEL_MAGIC,
+      .version = LEVEL_VERSION,
+      .grid_size = GRID_SIZE,
+      .apples_count = APPLES_COUNT,
+      .apple_zone_cells_count =
+          static_cast<uint32_t>(apple_zone_cells.size())};
+
+  const auto zone_size = apple_zone_cells.size() * sizeof(uint32_t);
+  std::vector<std::byte> file(sizeof(header) + zone_size + cells_count);
+  std::memcpy(file.data(), &header, sizeof(header));
+  std::memcpy(&file[sizeof(header)], apple_zone_cells.data(), zone_size);
+  std::memcpy(&file[sizeof(header) + zone_size], cells.data(), cells_count);
+
+  return file;
+}
+
+// maps file of given content and checks it with getLevel
+auto isLevelAccepted(const std::filesystem::path& path,
+                     const std::vector<std::byte>& file) -> bool {
+  std::ofstream{path, std::ios::binary}.write(
+      reinterpret_cast<const char*>(file.data()),  // NOLINT
+      static_cast<std::streamsize>(file.size()));
+
+  auto mapped_file = mapLevelFile(path.c_str());
+  if (!mapped_file.has_value()) {
+    return false;
+  }
+
+  const auto is_accepted =
+      getLevel(mapped_file->data, mapped_file->size).has_value();
+  unmapLevelFile(&mapped_file.value());
+
+  return is_accepted;
+}
+
+struct Corruption {
+  const char* name;
+  void (*corrupt)(std::vector<std::byte>* file);
+};
+
+auto getZoneCellOffset(std::size_t zone_idx) -> std::size_t {
+  return sizeof(LevelHeader) + zone_idx * sizeof(uint32_t);
+}
+
+auto getTerrainOffset(const std::vector<std::byte>& file) -> std::size_t {
+  return file.size() - std::size_t{6} * GRID_SIZE * GRID_SIZE;
+}
+
+const std::array<Corruption, 6> CORRUPTIONS{{
+    {.name = "truncated",
+     .corrupt = [](auto* file) { file->resize(file->size() - 1); }},
+    {.name = "truncated header",
+     .corrupt = [](auto* file) { file->resize(sizeof(LevelHeader) - 1); }},
+    {.name = "bad magic",
+     .corrupt = [](auto* file) { (*file)[0] ^= std::byte{0xFF}; }},
+    {.name = "extra byte",
+     .corrupt = [](auto* file) { file->push_back(std::byte{0}); }},
+    {.name = "apple in terrain",
+     .corrupt =
+         [](auto* file) {
+           (*file)[getTerrainOffset(*file) + 1] =
+               static_cast<std::byte>(ECellContent::Apple);
+         }},
+    {.name = "zone cell out of grid",
+     .corrupt =
+         [](auto* file) {
+           const uint32_t cell_idx = 6 * GRID_SIZE * GRID_SIZE;
+           std::memcpy(&(*file)[getZoneCellOffset(0)], &cell_idx,
+                       sizeof(cell_idx));
+         }},
+}};
+
+auto main() -> int {
+  const auto path =
+      std::filesystem::temp_directory_path() / "snake-level-test.bin";
+  const auto file = createLevelFile();
+
+  auto is_passed = isLevelAccepted(path, file);
+  std::printf("%-22s %s\n", "generated level",
+              is_passed ? "ok: accepted" : "FAILED: rejected");
+
+  for (const auto& [name, corrupt] : CORRUPTIONS) {
+    auto corrupted_file = file;
+    corrupt(&corrupted_file);
+
+    const auto is_rejected = !isLevelAccepted(path, corrupted_file);
+    std::printf("%-22s %s\n", name,
+                is_rejected ? "ok: rejected" : "FAILED: accepted");
+    is_passed = is_passed && is_rejected;
+  }
+
+  std::ofstream{path, std::ios::binary}.write(
+      reinterpret_cast<const char*>(file.data()),  // NOLINT
+      static_cast<std::streamsize>(file.size()));
+  auto mapped_file = mapLevelFile(path.c_str());
+  std::filesystem::remove(path);
+  if (!is_passed || !mapped_file.has_value()) {
+    std::printf("FAILED: level file checks\n");
+    return EXIT_FAILURE;
+  }
+
+  auto state = std::make_unique<GameState>();
+  state->board.random_engine.seed(1);
+  state->next_level = getLevel(mapped_file->data, mapped_file->size);
+
+  initGameState(state.get());
+
+  double plant_time = 0;
+  for (int i = 0; i < ROUNDS_COUNT; ++i) {
+    const auto plant_start = getNow();
+    plantObjects(state.get());
+    plant_time += getNow() - plant_start;
+  }
+
+  const auto& board = state->board;
+  const auto& level_cells = state->level->cells;
+  auto is_board_matched =
+      board.apples_count == static_cast<int>(APPLES_COUNT) &&
+      board.cells.size() == level_cells.size();
+  for (std::size_t i = 0; is_board_matched && i < level_cells.size(); ++i) {
+    const auto is_level_stone =
+        level_cells[i] == static_cast<uint8_t>(ECellContent::Stone);
+    const auto is_board_stone = board.cells[i] == ECellContent::Stone;
+    is_board_matched = is_level_stone == is_board_stone;
+  }
+
+  state.reset();
+  unmapLevelFile(&mapped_file.value());
+
+  if (!is_board_matched) {
+    std::printf("FAILED: board does not match level after planting\n");
+    return EXIT_FAILURE;
+  }
+
+  std::printf("ok: round start from mapped %dx%d level takes %.3f ms\n",
+              GRID_SIZE, GRID_SIZE, plant_time / ROUNDS_COUNT);
+
+  return EXIT_SUCCESS;
+}
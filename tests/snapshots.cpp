@@ -0,0 +1,196 @@
+// plays random rounds with all kinds of entities, fingerprints state after
+// each tick, and restores random ticks still kept by snapshots. restored
+// state has to match fingerprint recorded when that tick was first played,
+// down to order of free cells and random engine state, since both decide
+// what happens next
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../src/actions/game-actions.hpp"
+#include "../src/actions/snake-actions.hpp"
+#include "../src/actions/snapshot-actions.hpp"
+
+const int TICKS_COUNT = 20000;
+const int REWIND_PERIOD = 20;  // ticks, on average
+const int TURN_PERIOD = 16;    // ticks, on average
+
+// everything next ticks depend on, besides snake move timing
+struct Fingerprint {
+  int tick{-1};
+
+  std::vector<ECellContent> cells;
+  std::vector<int> free_cells;
+  std::vector<int> free_cells_positions;
+  std::vector<int> cells_entities;
+  int apples_count{0};
+  int stones_count{0};
+
+  Entities entities;
+
+  std::vector<CubePosition> snake_parts;
+  EDirection snake_direction{};
+  std::vector<EDirection> pending_turns;
+  double move_period{0};
+  bool is_crashed{false};
+
+  std::mt19937 random_engine;
+};
+
+auto getFingerprint(const GameState& state) -> Fingerprint {
+  const auto& board = state.board;
+  const auto& snake = state.snake;
+
+  Fingerprint fingerprint{
+      .tick = state.snapshots.tick,
+      .cells = board.cells,
+      .free_cells = board.free_cells,
+      .free_cells_positions = board.free_cells_positions,
+      .cells_entities = board.cells_entities,
+      .apples_count = board.apples_count,
+      .stones_count = board.stones_count,
+      .entities = state.entities,
+      .snake_parts = {snake.parts.begin(), snake.parts.end()},
+      .snake_direction = snake.direction,
+      .move_period = snake.move_period.count(),
+      .is_crashed = snake.is_crashed,
+      .random_engine = board.random_engine};
+
+  auto pending_turns = snake.pending_turns;
+  while (const auto turn = pending_turns.pop()) {
+    fingerprint.pending_turns.push_back(turn->direction);
+  }
+
+  return fingerprint;
+}
+
+// returns name of first part which differs, or nothing when all match
+auto getMismatch(const Fingerprint& restored, const Fingerprint& recorded)
+    -> const char* {
+  const auto& a = restored.entities;
+  const auto& b = recorded.entities;
+
+  if (restored.cells != recorded.cells) {
+    return "board cells";
+  }
+  if (restored.free_cells != recorded.free_cells) {
+    return "free cells";
+  }
+  if (restored.free_cells_positions != recorded.free_cells_positions) {
+    return "free cells positions";
+  }
+  if (restored.cells_entities != recorded.cells_entities) {
+    return "cells entities";
+  }
+  if (restored.apples_count != recorded.apples_count ||
+      restored.stones_count != recorded.stones_count) {
+    return "board counters";
+  }
+  if (a.positions != b.positions || a.kinds != b.kinds ||
+      a.behaviours != b.behaviours || a.timers != b.timers ||
+      a.directions != b.directions) {
+    return "entities";
+  }
+  if (restored.snake_parts != recorded.snake_parts) {
+    return "snake parts";
+  }
+  if (restored.snake_direction != recorded.snake_direction ||
+      restored.pending_turns != recorded.pending_turns ||
+      restored.move_period != recorded.move_period ||
+      restored.is_crashed != recorded.is_crashed) {
+    return "snake";
+  }
+  if (restored.random_engine != recorded.random_engine) {
+    return "random engine";
+  }
+
+  return nullptr;
+}
+
+auto main() -> int {
+  auto state = std::make_unique<GameState>();
+  state->board.random_engine.seed(1);
+  state->config = {.grid_size = 12,
+                   .apples_count = 15,
+                   .respawn_apples = true,
+                   .stones_count = 20,
+                   .wandering_stones_count = 10,
+                   .decaying_apples_count = 10,
+                   .slow_downs_count = 5};
+
+  initGameState(state.get());
+  startOrPauseGame(state.get());
+
+  std::mt19937 random_engine{1};
+  const auto is_chance = [&random_engine](int period) {
+    return std::uniform_int_distribution{1, period}(random_engine) == 1;
+  };
+
+  // fingerprints of ticks snapshots can keep, by tick % size
+  std::vector<Fingerprint> fingerprints(Snapshots::DELTAS_COUNT + 1);
+  const auto record = [&fingerprints, &state] {
+    auto fingerprint = getFingerprint(*state);
+    const auto slot = fingerprint.tick % fingerprints.size();
+    fingerprints[slot] = std::move(fingerprint);
+  };
+  record();
+
+  int restores_count = 0;
+  int max_restore_distance = 0;
+  int rounds_count = 1;
+
+  for (int i = 0; i < TICKS_COUNT; ++i) {
+    // snake mostly goes for apples, so rounds last long enough for restores
+    // to reach past several keyframes
+    steerToNearestApple(state.get());
+    if (is_chance(TURN_PERIOD)) {
+      const auto direction = static_cast<EDirection>(
+          std::uniform_int_distribution{0, 3}(random_engine));
+      queueSnakeTurn(state.get(), direction, 0);
+    }
+
+    playTick(state.get());
+
+    if (state->snake.is_crashed || state->board.apples_count == 0) {
+      plantObjects(state.get());
+      rounds_count += 1;
+    }
+
+    record();
+
+    if (!is_chance(REWIND_PERIOD)) {
+      continue;
+    }
+
+    const auto& snapshots = state->snapshots;
+    const auto tick = std::uniform_int_distribution{
+        snapshots.first_tick, snapshots.tick}(random_engine);
+    const auto distance = snapshots.tick - tick;
+    if (!restoreSnapshot(state.get(), tick)) {
+      std::printf("FAILED at tick %d: tick %d is not kept, though first kept "
+                  "tick is %d\n",
+                  i, tick, snapshots.first_tick);
+      return EXIT_FAILURE;
+    }
+    restores_count += 1;
+    max_restore_distance = std::max(max_restore_distance, distance);
+
+    const auto& recorded = fingerprints[tick % fingerprints.size()];
+    const auto* mismatch = getMismatch(getFingerprint(*state), recorded);
+    if (recorded.tick != tick || mismatch != nullptr) {
+      std::printf("FAILED at tick %d: restored tick %d differs in %s\n", i,
+                  tick, mismatch != nullptr ? mismatch : "tick");
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::printf("ok: %d restores up to %d ticks back matched recorded ticks "
+              "over %d ticks, %d rounds\n",
+              restores_count, max_restore_distance, TICKS_COUNT, rounds_count);
+
+  return EXIT_SUCCESS;
+}
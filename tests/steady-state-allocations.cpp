@@ -0,0 +1,46 @@
+// plays a lot of moves on scratch state and fails if any of them allocates
+// after warm-up. each config goes through different code paths: plain round,
+// round with all kinds of entities, and maze-like round which crashes often,
+// so new rounds are started a lot
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../src/actions/game-actions.hpp"
+#include "../src/models/GameConfig.hpp"
+
+const int TICKS_COUNT = 10000;
+
+struct TestConfig {
+  const char* name;
+  GameConfig config;
+};
+
+const std::array<TestConfig, 3> CONFIGS{{
+    {.name = "default", .config = {}},
+    {.name = "entities",
+     .config = {.respawn_apples = true,
+                .wandering_stones_count = 5,
+                .decaying_apples_count = 5,
+                .slow_downs_count = 5}},
+    {.name = "dense stones", .config = {.stones_density = 0.2}},
+}};
+
+auto main() -> int {
+  auto is_passed = true;
+
+  for (const auto& [name, config] : CONFIGS) {
+    const auto allocations = countSteadyStateAllocations(config, TICKS_COUNT);
+    const auto is_config_passed = allocations.count == 0;
+
+    std::printf("%-16s %s: %lld allocations, %lld bytes in %d ticks\n", name,
+                is_config_passed ? "ok" : "FAILED",
+                static_cast<long long>(allocations.count),
+                static_cast<long long>(allocations.bytes), TICKS_COUNT);
+
+    is_passed = is_passed && is_config_passed;
+  }
+
+  return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
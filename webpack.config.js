@@ -25,7 +25,6 @@ module.exports = {
       patterns: [
         { from: staticDir },
         { from: path.resolve(buildDir, "main.wasm") },
-        { from: path.resolve(buildDir, "main.data") },
       ]
     }),
   ],